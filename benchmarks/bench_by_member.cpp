@@ -0,0 +1,85 @@
+#include "bench_by_member.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_by_member.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+
+   // 64-byte record with the id as null field
+   struct record
+   {
+      std::int64_t id = 0;
+      std::int64_t payload[7]{};
+
+      constexpr auto operator==(const record&) const -> bool = default;
+   };
+   static_assert(sizeof(record) == 64);
+
+   constexpr record null_record{ -1, { -1, -1, -1, -1, -1, -1, -1 } };
+
+   using by_member_type = io::intrusive_optional_by_member<&record::id, std::int64_t{ -1 }>;
+   using whole_struct_type = io::intrusive_optional<null_record>;
+
+
+   template <typename opt_type>
+   auto bench_type(io::bench::suite& suite, const std::string& optional_name) -> void
+   {
+      std::vector<opt_type> column(element_count);
+      std::mt19937 generator(42);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (generator() % 2 == 0)
+         {
+            record value{ static_cast<std::int64_t>(i), {} };
+            column[i] = value;
+         }
+      }
+      constexpr std::uint64_t bytes = element_count * sizeof(record);
+
+      suite.run("record has_value", "record64", optional_name, element_count, bytes, [&]()
+      {
+         std::size_t count = 0;
+         for (const opt_type& element : column)
+         {
+            count += element.has_value() ? 1 : 0;
+         }
+         io::bench::do_not_optimize(count);
+      });
+
+      suite.run("record sum of engaged ids", "record64", optional_name, element_count, bytes, [&]()
+      {
+         std::int64_t sum = 0;
+         for (const opt_type& element : column)
+         {
+            if (element.has_value())
+               sum += element->id;
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      std::vector<opt_type> target = column;
+      suite.run("record reset", "record64", optional_name, element_count, bytes, [&]()
+      {
+         for (opt_type& element : target)
+         {
+            element.reset();
+         }
+         io::bench::do_not_optimize(target);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_by_member(io::bench::suite& suite) -> void
+{
+   bench_type<by_member_type>(suite, "intrusive_optional_by_member");
+   bench_type<whole_struct_type>(suite, "intrusive_optional");
+}
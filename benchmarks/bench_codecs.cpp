@@ -0,0 +1,100 @@
+#include "bench_codecs.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_codecs.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 20;
+   using opt_type = io::intrusive_optional<std::int64_t{ -1 }>;
+
+
+   // Runs of nulls and values with lengths of 1 to 128, a run being null with the given probability.
+   // The values are 256 distinct ids above 10^9, which all three codecs can exploit.
+   auto make_column(const double null_fraction) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      std::mt19937 generator(42);
+      std::bernoulli_distribution is_null(null_fraction);
+      std::size_t i = 0;
+      while (i < element_count)
+      {
+         const std::size_t end = std::min<std::size_t>(i + 1 + generator() % 128, element_count);
+         const bool null_run = is_null(generator);
+         for (; i < end; ++i)
+         {
+            if (null_run == false)
+               result[i].emplace(1'000'000'000 + static_cast<std::int64_t>(generator() % 256));
+         }
+      }
+      return result;
+   }
+
+
+   // The bytes of the decode workloads are the encoded sizes. Compared to the raw copy, they're
+   // the compression ratio.
+   auto bench_density(io::bench::suite& suite, const double null_fraction) -> void
+   {
+      const std::vector<opt_type> column = make_column(null_fraction);
+      std::vector<opt_type> output(element_count);
+      const std::string suffix = " (" + std::to_string(static_cast<int>(null_fraction * 100)) + "% null)";
+      constexpr std::uint64_t column_bytes = element_count * sizeof(opt_type);
+
+      suite.run("column decode" + suffix, "int64_t", "raw copy", element_count, column_bytes, [&]()
+      {
+         std::ranges::copy(column, output.begin());
+         io::bench::do_not_optimize(output.data());
+      });
+
+      const auto null_runs = io::encode_null_runs(column);
+      suite.run("column decode" + suffix, "int64_t", "null runs", element_count, null_runs.size_in_bytes(), [&]()
+      {
+         io::decode_null_runs(null_runs, output);
+         io::bench::do_not_optimize(output.data());
+      });
+
+      const auto frame = io::encode_frame_of_reference(column);
+      suite.run("column decode" + suffix, "int64_t", "frame of reference", element_count, frame.size_in_bytes(), [&]()
+      {
+         io::decode_frame_of_reference(frame, output);
+         io::bench::do_not_optimize(output.data());
+      });
+
+      const auto dictionary = io::encode_dictionary(column);
+      suite.run("column decode" + suffix, "int64_t", "dictionary", element_count, dictionary.size_in_bytes(), [&]()
+      {
+         io::decode_dictionary(dictionary, output);
+         io::bench::do_not_optimize(output.data());
+      });
+
+      suite.run("column encode" + suffix, "int64_t", "null runs", element_count, column_bytes, [&]()
+      {
+         io::bench::do_not_optimize(io::encode_null_runs(column));
+      });
+      suite.run("column encode" + suffix, "int64_t", "frame of reference", element_count, column_bytes, [&]()
+      {
+         io::bench::do_not_optimize(io::encode_frame_of_reference(column));
+      });
+      suite.run("column encode" + suffix, "int64_t", "dictionary", element_count, column_bytes, [&]()
+      {
+         io::bench::do_not_optimize(io::encode_dictionary(column));
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_codecs(io::bench::suite& suite) -> void
+{
+   for (const double null_fraction : { 0.1, 0.5, 0.9 })
+   {
+      bench_density(suite, null_fraction);
+   }
+}
@@ -0,0 +1,237 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+namespace io::bench
+{
+
+   // Keeps the compiler from optimizing away a computed value
+   template <typename T>
+   auto do_not_optimize(const T& value) -> void
+   {
+#if defined(__GNUC__) || defined(__clang__)
+      asm volatile("" : : "r,m"(value) : "memory");
+#else
+      static volatile const void* sink;
+      sink = &value;
+#endif
+   }
+
+
+   // Hardware counters via perf_event_open. Everything is optional: On other platforms or without
+   // permission (see /proc/sys/kernel/perf_event_paranoid) the counters just stay empty.
+   class perf_counters
+   {
+#if defined(__linux__)
+      int m_cycles_fd = -1;
+      int m_cache_misses_fd = -1;
+
+      static auto open_counter(const std::uint64_t config, const int group_fd) -> int
+      {
+         perf_event_attr attributes{};
+         attributes.type = PERF_TYPE_HARDWARE;
+         attributes.size = sizeof(perf_event_attr);
+         attributes.config = config;
+         attributes.disabled = group_fd == -1 ? 1 : 0;
+         attributes.exclude_kernel = 1;
+         attributes.exclude_hv = 1;
+         return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, group_fd, 0));
+      }
+
+      static auto read_counter(const int fd) -> std::optional<std::uint64_t>
+      {
+         std::uint64_t value = 0;
+         if (fd == -1 || read(fd, &value, sizeof(value)) != sizeof(value))
+         {
+            return std::nullopt;
+         }
+         return value;
+      }
+#endif
+
+   public:
+      struct sample
+      {
+         std::optional<std::uint64_t> cycles;
+         std::optional<std::uint64_t> cache_misses;
+      };
+
+      perf_counters()
+      {
+#if defined(__linux__)
+         m_cycles_fd = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+         if (m_cycles_fd != -1)
+         {
+            m_cache_misses_fd = open_counter(PERF_COUNT_HW_CACHE_MISSES, m_cycles_fd);
+         }
+#endif
+      }
+
+      perf_counters(const perf_counters&) = delete;
+      auto operator=(const perf_counters&) -> perf_counters& = delete;
+
+      ~perf_counters()
+      {
+#if defined(__linux__)
+         if (m_cache_misses_fd != -1)
+            close(m_cache_misses_fd);
+         if (m_cycles_fd != -1)
+            close(m_cycles_fd);
+#endif
+      }
+
+      auto start() -> void
+      {
+#if defined(__linux__)
+         if (m_cycles_fd != -1)
+         {
+            ioctl(m_cycles_fd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(m_cycles_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+         }
+#endif
+      }
+
+      auto stop() -> sample
+      {
+         sample result;
+#if defined(__linux__)
+         if (m_cycles_fd != -1)
+         {
+            ioctl(m_cycles_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            result.cycles = read_counter(m_cycles_fd);
+            result.cache_misses = read_counter(m_cache_misses_fd);
+         }
+#endif
+         return result;
+      }
+   };
+
+
+   struct result
+   {
+      std::string workload;
+      std::string value_type;
+      std::string optional_type;
+      std::size_t operations = 0;
+      double ns_per_operation = 0.0;
+      std::optional<std::uint64_t> cycles;
+      std::optional<std::uint64_t> cache_misses;
+
+      // Estimated from the element count and size, not measured
+      std::uint64_t bytes_touched = 0;
+   };
+
+
+   class suite
+   {
+      std::vector<result> m_results;
+      perf_counters m_counters;
+      int m_repetitions;
+
+   public:
+      explicit suite(const int repetitions = 5)
+         : m_repetitions(repetitions)
+      { }
+
+      // Runs fn() repeatedly and records the fastest repetition. fn must perform the given number of
+      // operations per call.
+      template <typename fn_type>
+      auto run(
+         const std::string& workload,
+         const std::string& value_type,
+         const std::string& optional_type,
+         const std::size_t operations,
+         const std::uint64_t bytes_touched,
+         fn_type&& fn
+      ) -> void
+      {
+         fn(); // warm-up
+
+         result best{ workload, value_type, optional_type, operations, 0.0, {}, {}, bytes_touched };
+         for (int repetition = 0; repetition < m_repetitions; ++repetition)
+         {
+            m_counters.start();
+            const auto begin = std::chrono::steady_clock::now();
+            fn();
+            const auto end = std::chrono::steady_clock::now();
+            const perf_counters::sample sample = m_counters.stop();
+
+            const double ns = std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(operations);
+            if (repetition == 0 || ns < best.ns_per_operation)
+            {
+               best.ns_per_operation = ns;
+               best.cycles = sample.cycles;
+               best.cache_misses = sample.cache_misses;
+            }
+         }
+         m_results.push_back(best);
+      }
+
+      [[nodiscard]] auto results() const -> const std::vector<result>&
+      {
+         return m_results;
+      }
+
+      auto write_table(std::ostream& stream) const -> void
+      {
+         for (const result& entry : m_results)
+         {
+            stream << entry.workload << " [" << entry.value_type << ", " << entry.optional_type << "]: "
+               << entry.ns_per_operation << " ns/op";
+            if (entry.cycles.has_value())
+            {
+               stream << ", " << static_cast<double>(*entry.cycles) / static_cast<double>(entry.operations) << " cycles/op";
+            }
+            if (entry.cache_misses.has_value())
+            {
+               stream << ", " << *entry.cache_misses << " cache misses";
+            }
+            stream << '\n';
+         }
+      }
+
+      auto write_json(std::ostream& stream) const -> void
+      {
+         const auto write_optional = [&](const std::optional<std::uint64_t>& value)
+         {
+            if (value.has_value())
+               stream << *value;
+            else
+               stream << "null";
+         };
+
+         stream << "{\n  \"results\": [\n";
+         for (std::size_t i = 0; i < m_results.size(); ++i)
+         {
+            const result& entry = m_results[i];
+            stream << "    {\"workload\": \"" << entry.workload
+               << "\", \"value_type\": \"" << entry.value_type
+               << "\", \"optional_type\": \"" << entry.optional_type
+               << "\", \"operations\": " << entry.operations
+               << ", \"ns_per_operation\": " << entry.ns_per_operation
+               << ", \"cycles\": ";
+            write_optional(entry.cycles);
+            stream << ", \"cache_misses\": ";
+            write_optional(entry.cache_misses);
+            stream << ", \"bytes_touched\": " << entry.bytes_touched << "}";
+            stream << (i + 1 < m_results.size() ? ",\n" : "\n");
+         }
+         stream << "  ]\n}\n";
+      }
+   };
+
+} // namespace io::bench
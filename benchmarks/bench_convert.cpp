@@ -0,0 +1,74 @@
+#include "bench_convert.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../intrusive_optional_convert.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 20;
+
+   using opt_i64 = io::intrusive_optional<std::int64_t{ -1 }>;
+   using opt_i32 = io::intrusive_optional<std::numeric_limits<std::int32_t>::max()>;
+   using opt_double = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+   using opt_float = io::intrusive_optional<std::numeric_limits<float>::quiet_NaN()>;
+
+
+   template <typename from_type, typename to_type>
+   auto bench_conversion(io::bench::suite& suite, const std::vector<from_type>& input, const std::string& workload, const std::string& value_type_name) -> void
+   {
+      std::vector<to_type> output(input.size());
+      const std::uint64_t bytes = input.size() * (sizeof(from_type) + sizeof(to_type));
+
+      suite.run(workload, value_type_name, "convert_column", input.size(), bytes, [&]()
+      {
+         io::bench::do_not_optimize(io::convert_column(input, output));
+         io::bench::do_not_optimize(output);
+      });
+
+      // Keeps source sentinels as values and doesn't saturate, so it's a lower bound
+      suite.run(workload, value_type_name, "converting constructor", input.size(), bytes, [&]()
+      {
+         for (std::size_t i = 0; i < input.size(); ++i)
+         {
+            output[i] = to_type(input[i]);
+         }
+         io::bench::do_not_optimize(output);
+      });
+
+      // Element-wise with the sentinels mapped, like the kernel but without saturation
+      suite.run(workload, value_type_name, "element-wise branch", input.size(), bytes, [&]()
+      {
+         using value_type = typename to_type::value_type;
+         for (std::size_t i = 0; i < input.size(); ++i)
+         {
+            output[i] = input[i].has_value() ? to_type(static_cast<value_type>(*input[i])) : to_type{};
+         }
+         io::bench::do_not_optimize(output);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_convert(io::bench::suite& suite) -> void
+{
+   std::mt19937 generator(42);
+   std::vector<opt_i64> integers(element_count);
+   std::vector<opt_double> doubles(element_count);
+   for (std::size_t i = 0; i < element_count; ++i)
+   {
+      if (generator() % 4 != 0)
+      {
+         *integers[i] = static_cast<std::int64_t>(generator() % 1000000);
+         *doubles[i] = static_cast<double>(generator() % 1000000) / 8.0;
+      }
+   }
+   bench_conversion<opt_i64, opt_i32>(suite, integers, "convert column", "int64->int32");
+   bench_conversion<opt_double, opt_float>(suite, doubles, "convert column", "double->float");
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "bench_common.h"
+
+namespace io {
+   auto bench_convert(bench::suite& suite) -> void;
+}
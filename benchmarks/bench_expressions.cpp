@@ -0,0 +1,69 @@
+#include "bench_expressions.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "../intrusive_optional_expressions.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 20;
+   using opt_type = io::intrusive_optional<std::numeric_limits<double>::max()>;
+
+
+   auto make_column(const unsigned seed) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      std::mt19937 generator(seed);
+      std::uniform_real_distribution<double> values(-100.0, 100.0);
+      for (opt_type& opt : result)
+      {
+         if (generator() % 10 != 0)
+            opt.emplace(values(generator));
+      }
+      return result;
+   }
+
+} // namespace {}
+
+
+// out = a * b + c with 10% nulls per input
+auto io::bench_expressions(io::bench::suite& suite) -> void
+{
+   const std::vector<opt_type> a = make_column(1);
+   const std::vector<opt_type> b = make_column(2);
+   const std::vector<opt_type> c = make_column(3);
+   std::vector<opt_type> temporary(element_count);
+   std::vector<opt_type> output(element_count);
+   constexpr std::uint64_t bytes = 4 * element_count * sizeof(opt_type);
+
+   suite.run("a * b + c", "double", "fused expression", element_count, bytes, [&]()
+   {
+      io::evaluate(io::col(a) * io::col(b) + io::col(c), output);
+      io::bench::do_not_optimize(output.data());
+   });
+
+   // One loop per operator over the optional API, with a temporary column
+   suite.run("a * b + c", "double", "materialized steps", element_count, bytes + 2 * element_count * sizeof(opt_type), [&]()
+   {
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (a[i].has_value() && b[i].has_value())
+            temporary[i] = *a[i] * *b[i];
+         else
+            temporary[i].reset();
+      }
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (temporary[i].has_value() && c[i].has_value())
+            output[i] = *temporary[i] + *c[i];
+         else
+            output[i].reset();
+      }
+      io::bench::do_not_optimize(output.data());
+   });
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "bench_common.h"
+
+namespace io {
+   auto bench_expressions(bench::suite& suite) -> void;
+}
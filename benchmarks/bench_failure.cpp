@@ -0,0 +1,86 @@
+#include "bench_failure.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_failure.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 18;
+
+
+   // The checks never fail here, so this measures what the failure path costs the hot loop
+   template <typename failure_policy>
+   auto bench_policy(io::bench::suite& suite, const std::string& optional_name) -> void
+   {
+      using opt_type = io::intrusive_optional<std::int32_t{ -1 }, io::safety_mode_t::unsafe, io::no_telemetry, failure_policy>;
+      using safe_type = io::intrusive_optional<std::int32_t{ -1 }, io::safety_mode_t::safe, io::no_telemetry, failure_policy>;
+      constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+      std::vector<opt_type> column(element_count);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         column[i] = static_cast<std::int32_t>(i & 1023);
+      }
+      suite.run("value() sum", "int32", optional_name, element_count, bytes, [&]()
+      {
+         std::int64_t sum = 0;
+         for (const opt_type& element : column)
+         {
+            sum += element.value();
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      std::vector<safe_type> safe_column(element_count);
+      suite.run("safe emplace", "int32", optional_name, element_count, bytes, [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            safe_column[i].emplace(static_cast<std::int32_t>(i & 1023));
+         }
+         io::bench::do_not_optimize(safe_column.data());
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_failure(io::bench::suite& suite) -> void
+{
+   bench_policy<io::throw_on_failure>(suite, "throw_on_failure");
+   bench_policy<io::abort_on_failure>(suite, "abort_on_failure");
+   bench_policy<io::callback_on_failure>(suite, "callback_on_failure");
+
+   // Without a failure: try_value() and try_emplace() return an error code
+   using opt_type = io::intrusive_optional<std::int32_t{ -1 }>;
+   std::vector<opt_type> column(element_count);
+   for (std::size_t i = 0; i < element_count; ++i)
+   {
+      column[i] = static_cast<std::int32_t>(i & 1023);
+   }
+   constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+   suite.run("value() sum", "int32", "try_value", element_count, bytes, [&]()
+   {
+      std::int64_t sum = 0;
+      for (const opt_type& element : column)
+      {
+         const io::value_result<const std::int32_t> result = element.try_value();
+         sum += result ? *result : 0;
+      }
+      io::bench::do_not_optimize(sum);
+   });
+   suite.run("safe emplace", "int32", "try_emplace", element_count, bytes, [&]()
+   {
+      std::size_t failures = 0;
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         failures += column[i].try_emplace(static_cast<std::int32_t>(i & 1023)) != io::optional_errc::none;
+      }
+      io::bench::do_not_optimize(failures);
+   });
+}
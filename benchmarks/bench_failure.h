@@ -0,0 +1,7 @@
+#pragma once
+
+#include "bench_common.h"
+
+namespace io {
+   auto bench_failure(bench::suite& suite) -> void;
+}
@@ -0,0 +1,91 @@
+#include "bench_fill.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../intrusive_optional_algorithms.h"
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<std::numeric_limits<double>::max()>;
+
+
+   // Samples with gaps of 1 to 16 missing values, about a third of the column
+   auto make_column(const std::size_t size) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(size);
+      std::mt19937 generator(42);
+      std::size_t i = 0;
+      while (i < size)
+      {
+         const std::size_t value_end = std::min<std::size_t>(i + 1 + generator() % 32, size);
+         for (; i < value_end; ++i)
+         {
+            result[i].emplace(static_cast<double>(i) * 0.5);
+         }
+         i = std::min<std::size_t>(i + 1 + generator() % 16, size);
+      }
+      return result;
+   }
+
+
+   // The fills work in place, so every run first restores the column from the original. That copy
+   // is part of each measurement, including the scalar baseline.
+   auto bench_size(io::bench::suite& suite, const std::size_t size) -> void
+   {
+      const std::vector<opt_type> original = make_column(size);
+      std::vector<opt_type> column(size);
+      const std::string suffix = " (" + std::to_string(size) + " samples)";
+      const std::uint64_t bytes = 3 * size * sizeof(opt_type);
+
+      const auto run = [&](const std::string& workload, const std::string& implementation, const auto& fill)
+      {
+         suite.run(workload + suffix, "double", implementation, size, bytes, [&]()
+         {
+            std::ranges::copy(original, column.begin());
+            fill();
+            io::bench::do_not_optimize(column.data());
+         });
+      };
+
+      run("forward fill", "branching has_value() loop", [&]()
+      {
+         double last = opt_type::null_value;
+         for (opt_type& opt : column)
+         {
+            if (opt.has_value())
+               last = *opt;
+            else
+               *opt = last;
+         }
+      });
+      run("forward fill", "forward_fill", [&]() { io::forward_fill(column); });
+      run("forward fill", "parallel_forward_fill", [&]() { io::parallel_forward_fill(column); });
+      run("forward fill, limit 4", "forward_fill", [&]() { io::forward_fill(column, 4); });
+      run("forward fill, limit 4", "parallel_forward_fill", [&]() { io::parallel_forward_fill(column, 4, std::thread::hardware_concurrency()); });
+      run("backward fill", "backward_fill", [&]() { io::backward_fill(column); });
+      run("backward fill", "parallel_backward_fill", [&]() { io::parallel_backward_fill(column); });
+      run("backward fill, limit 4", "backward_fill", [&]() { io::backward_fill(column, 4); });
+      run("backward fill, limit 4", "parallel_backward_fill", [&]() { io::parallel_backward_fill(column, 4, std::thread::hardware_concurrency()); });
+      run("linear interpolation", "interpolate_linear", [&]() { io::interpolate_linear(column); });
+      run("linear interpolation", "parallel_interpolate_linear", [&]() { io::parallel_interpolate_linear(column); });
+   }
+
+} // namespace {}
+
+
+// 10^6 to 10^8 samples. 10^9 samples would need 16 GB for the original and the working column.
+auto io::bench_fill(io::bench::suite& suite) -> void
+{
+   for (const std::size_t size : { std::size_t{ 1'000'000 }, std::size_t{ 10'000'000 }, std::size_t{ 100'000'000 } })
+   {
+      bench_size(suite, size);
+   }
+}
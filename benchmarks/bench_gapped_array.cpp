@@ -0,0 +1,137 @@
+#include "bench_gapped_array.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_gapped_array.h"
+
+
+namespace
+{
+
+   // Smaller than in the other benchmarks since inserts into a sorted vector are quadratic
+   constexpr std::size_t element_count = 1 << 14;
+   using array_type = io::gapped_sorted_array<std::uint64_t{ 0 }>;
+
+
+   // Sorted std::vector with insertion, the simplest alternative
+   class sorted_vector
+   {
+      std::vector<std::uint64_t> m_values;
+
+   public:
+      auto insert(const std::uint64_t value) -> bool
+      {
+         const auto it = std::ranges::lower_bound(m_values, value);
+         if (it != m_values.end() && *it == value)
+            return false;
+         m_values.insert(it, value);
+         return true;
+      }
+
+      [[nodiscard]] auto contains(const std::uint64_t value) const -> bool
+      {
+         return std::ranges::binary_search(m_values, value);
+      }
+
+      template <typename fn_type>
+      auto scan(const std::uint64_t lo, const std::uint64_t hi, fn_type&& fn) const -> void
+      {
+         for (auto it = std::ranges::lower_bound(m_values, lo); it != m_values.end() && *it <= hi; ++it)
+         {
+            fn(*it);
+         }
+      }
+   };
+
+
+   class std_set
+   {
+      std::set<std::uint64_t> m_values;
+
+   public:
+      auto insert(const std::uint64_t value) -> bool
+      {
+         return m_values.insert(value).second;
+      }
+
+      [[nodiscard]] auto contains(const std::uint64_t value) const -> bool
+      {
+         return m_values.contains(value);
+      }
+
+      template <typename fn_type>
+      auto scan(const std::uint64_t lo, const std::uint64_t hi, fn_type&& fn) const -> void
+      {
+         for (auto it = m_values.lower_bound(lo); it != m_values.end() && *it <= hi; ++it)
+         {
+            fn(*it);
+         }
+      }
+   };
+
+
+   template <typename set_type>
+   auto bench_set(io::bench::suite& suite, const std::string& name, const std::vector<std::uint64_t>& ids) -> void
+   {
+      constexpr std::uint64_t bytes = element_count * sizeof(std::uint64_t);
+      const auto run = [&](const std::string& workload, auto&& fn)
+      {
+         suite.run(workload, "uint64_t", name, element_count, bytes, fn);
+      };
+
+      run("sorted set insert", [&]()
+      {
+         set_type set;
+         for (const std::uint64_t id : ids)
+         {
+            set.insert(id);
+         }
+         io::bench::do_not_optimize(set);
+      });
+
+      set_type set;
+      for (const std::uint64_t id : ids)
+      {
+         set.insert(id);
+      }
+
+      run("sorted set lookup", [&]()
+      {
+         std::size_t found = 0;
+         for (const std::uint64_t id : ids)
+         {
+            found += set.contains(id + 1) ? 1 : 0;
+         }
+         io::bench::do_not_optimize(found);
+      });
+
+      run("sorted set scan", [&]()
+      {
+         std::uint64_t sum = 0;
+         set.scan(1, std::numeric_limits<std::uint64_t>::max() - 1, [&](const std::uint64_t id) { sum += id; });
+         io::bench::do_not_optimize(sum);
+      });
+   }
+
+} // namespace {}
+
+
+// There's no B-tree in the standard library, so std::set stands in for the node-based designs
+auto io::bench_gapped_array(io::bench::suite& suite) -> void
+{
+   std::vector<std::uint64_t> ids(element_count);
+   std::mt19937_64 generator(42);
+   for (std::uint64_t& id : ids)
+   {
+      id = generator() % (element_count * 16) + 1;
+   }
+
+   bench_set<array_type>(suite, "gapped_sorted_array", ids);
+   bench_set<std_set>(suite, "std::set", ids);
+   bench_set<sorted_vector>(suite, "sorted std::vector", ids);
+}
@@ -0,0 +1,105 @@
+#include "bench_join.h"
+
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "../intrusive_optional_join.h"
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<std::int64_t{ -1 }>;
+
+   constexpr std::size_t left_count = 1 << 18;
+   constexpr std::size_t right_count = 1 << 16;
+
+
+   // Keys drawn from [0, key_range) with 10% nulls
+   auto make_keys(const std::size_t size, const std::int64_t key_range, const unsigned seed) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(size);
+      std::mt19937 generator(seed);
+      for (opt_type& opt : result)
+      {
+         if (generator() % 10 != 0)
+            opt.emplace(static_cast<std::int64_t>(generator() % static_cast<std::uint64_t>(key_range)));
+      }
+      return result;
+   }
+
+} // namespace {}
+
+
+auto io::bench_join(io::bench::suite& suite) -> void
+{
+   const std::vector<opt_type> left = make_keys(left_count, 2 * right_count, 1);
+   const std::vector<opt_type> right = make_keys(right_count, 2 * right_count, 2);
+   constexpr std::uint64_t bytes = (left_count + right_count) * sizeof(opt_type);
+
+   suite.run("inner join", "int64_t", "hash_join", left_count, bytes, [&]()
+   {
+      io::bench::do_not_optimize(io::inner_join(left, right));
+   });
+
+   // The same result with the null keys skipped, which is what null_key_policy::distinct does
+   suite.run("inner join", "int64_t", "std::unordered_multimap", left_count, bytes, [&]()
+   {
+      std::unordered_multimap<std::int64_t, std::size_t> index;
+      index.reserve(right_count);
+      for (std::size_t i = 0; i < right_count; ++i)
+      {
+         if (right[i].has_value())
+            index.emplace(*right[i], i);
+      }
+      io::join_result result;
+      for (std::size_t i = 0; i < left_count; ++i)
+      {
+         if (left[i].has_value() == false)
+            continue;
+         const auto [begin, end] = index.equal_range(*left[i]);
+         for (auto it = begin; it != end; ++it)
+         {
+            result.left_rows.push_back(i);
+            result.right_rows.emplace_back(it->second);
+         }
+      }
+      io::bench::do_not_optimize(result);
+   });
+
+   suite.run("left join", "int64_t", "hash_join", left_count, bytes, [&]()
+   {
+      io::bench::do_not_optimize(io::left_join(left, right));
+   });
+
+   suite.run("group by", "int64_t", "group_by", left_count, left_count * sizeof(opt_type), [&]()
+   {
+      io::bench::do_not_optimize(io::group_by(left, io::null_key_policy::group));
+   });
+
+   suite.run("group by", "int64_t", "std::unordered_map", left_count, left_count * sizeof(opt_type), [&]()
+   {
+      std::unordered_map<std::int64_t, std::uint32_t> groups;
+      std::vector<std::uint32_t> group_ids(left_count);
+      std::uint32_t null_group = 0;
+      bool has_null_group = false;
+      for (std::size_t i = 0; i < left_count; ++i)
+      {
+         const auto next_id = static_cast<std::uint32_t>(groups.size() + (has_null_group ? 1 : 0));
+         if (left[i].has_value() == false)
+         {
+            if (has_null_group == false)
+            {
+               null_group = next_id;
+               has_null_group = true;
+            }
+            group_ids[i] = null_group;
+            continue;
+         }
+         group_ids[i] = groups.try_emplace(*left[i], next_id).first->second;
+      }
+      io::bench::do_not_optimize(group_ids.data());
+   });
+}
@@ -0,0 +1,98 @@
+#include "bench_modify.h"
+
+#include <cstdint>
+#include <vector>
+
+#include "../intrusive_optional.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 14;
+
+   // 64 bytes. All fields take part in the comparison with the sentinel.
+   struct record
+   {
+      std::int64_t id = 0;
+      std::int64_t values[7]{};
+      constexpr auto operator==(const record&) const -> bool = default;
+   };
+   static_assert(sizeof(record) == 64);
+
+   // Same, but only the id is compared, and the values are declared independent of the sentinel
+   struct keyed_record
+   {
+      std::int64_t id = 0;
+      std::int64_t values[7]{};
+      constexpr auto operator==(const keyed_record& other) const -> bool
+      {
+         return id == other.id;
+      }
+   };
+
+} // namespace {}
+
+
+template <>
+struct io::sentinel_independent_member<&keyed_record::values> : std::true_type {};
+
+
+namespace
+{
+
+   using safe_record = io::intrusive_optional<record{ -1 }, io::safety_mode_t::safe>;
+   using safe_keyed_record = io::intrusive_optional<keyed_record{ -1 }, io::safety_mode_t::safe>;
+
+
+   // Increments one field of every record in place
+   template <typename opt_type>
+   auto bench_type(io::bench::suite& suite, const std::string& value_type_name) -> void
+   {
+      using value_type = typename opt_type::value_type;
+      std::vector<opt_type> column;
+      column.reserve(element_count);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         column.emplace_back(value_type{ static_cast<std::int64_t>(i) });
+      }
+      constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+      suite.run("safe mode mutation", value_type_name, "copy-modify-assign", element_count, bytes, [&]()
+      {
+         for (opt_type& element : column)
+         {
+            value_type copy = *element;
+            copy.values[3] += 1;
+            element = copy;
+         }
+         io::bench::do_not_optimize(column.data());
+      });
+
+      suite.run("safe mode mutation", value_type_name, "modify", element_count, bytes, [&]()
+      {
+         for (opt_type& element : column)
+         {
+            element.modify([](value_type& value) { value.values[3] += 1; });
+         }
+         io::bench::do_not_optimize(column.data());
+      });
+
+      suite.run("safe mode mutation", value_type_name, "modify<member>", element_count, bytes, [&]()
+      {
+         for (opt_type& element : column)
+         {
+            element.template modify<&value_type::values>([](std::int64_t (&values)[7]) { values[3] += 1; });
+         }
+         io::bench::do_not_optimize(column.data());
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_modify(io::bench::suite& suite) -> void
+{
+   bench_type<safe_record>(suite, "64-byte record");
+   bench_type<safe_keyed_record>(suite, "64-byte keyed record");
+}
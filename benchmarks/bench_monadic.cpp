@@ -0,0 +1,94 @@
+#include "bench_monadic.h"
+
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+   using opt_type = io::intrusive_optional<-1>;
+
+
+   // Index table with roughly a quarter of the entries null, so chains of two lookups end early
+   // in about half of the cases
+   auto make_table() -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      std::mt19937 generator(42);
+      for (opt_type& entry : result)
+      {
+         if (generator() % 4 != 0)
+            entry.emplace(static_cast<int>(generator() % element_count));
+      }
+      return result;
+   }
+
+} // namespace {}
+
+
+auto io::bench_monadic(io::bench::suite& suite) -> void
+{
+   const std::vector<opt_type> table = make_table();
+   constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+   const auto lookup = [&](const int index) -> const opt_type& { return table[static_cast<std::size_t>(index)]; };
+
+   suite.run("lookup chain (monadic)", "int", "intrusive_optional", element_count, bytes, [&]()
+   {
+      std::uint64_t sum = 0;
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         sum += static_cast<std::uint64_t>(table[i]
+            .and_then(lookup)
+            .and_then(lookup)
+            .transform([](const int value) { return value * 2; })
+            .value_or_else([]() { return 0; }));
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   // The same chain through std::optional, as before the monadic interface existed
+   suite.run("lookup chain (get_std)", "int", "intrusive_optional", element_count, bytes, [&]()
+   {
+      std::uint64_t sum = 0;
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         std::optional<int> value = table[i].get_std();
+         if (value.has_value())
+            value = lookup(*value).get_std();
+         if (value.has_value())
+            value = lookup(*value).get_std();
+         if (value.has_value())
+            value = *value * 2;
+         sum += static_cast<std::uint64_t>(value.has_value() ? *value : 0);
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   suite.run("value_or_else", "int", "intrusive_optional", element_count, bytes, [&]()
+   {
+      std::uint64_t sum = 0;
+      for (const opt_type& entry : table)
+      {
+         sum += static_cast<std::uint64_t>(entry.value_or_else([&]() { return static_cast<int>(sum & 0xff); }));
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   suite.run("value_or_else (get_std)", "int", "intrusive_optional", element_count, bytes, [&]()
+   {
+      std::uint64_t sum = 0;
+      for (const opt_type& entry : table)
+      {
+         const std::optional<int> value = entry.get_std();
+         sum += static_cast<std::uint64_t>(value.has_value() ? *value : static_cast<int>(sum & 0xff));
+      }
+      io::bench::do_not_optimize(sum);
+   });
+}
@@ -0,0 +1,328 @@
+#include "bench_optionals.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "../tests/tests_common.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+   int pointer_targets[element_count];
+
+
+   // Pseudo-random null pattern with roughly half of the elements null, so that branches on
+   // has_value() aren't trivially predictable
+   [[nodiscard]] constexpr auto is_null_element(const std::size_t i) -> bool
+   {
+      return ((i * 2654435761u) >> 13) & 1u;
+   }
+
+
+   template <typename T>
+   struct value_traits;
+
+   template <>
+   struct value_traits<int>
+   {
+      static constexpr const char* name = "int";
+      static constexpr int null_value = -1;
+      static auto make(const std::size_t i) -> int { return static_cast<int>(i); }
+      static auto to_number(const int value) -> std::uint64_t { return static_cast<std::uint64_t>(value); }
+      using conversion_source = short;
+      static constexpr short conversion_null_value = -1;
+   };
+
+   template <>
+   struct value_traits<double>
+   {
+      static constexpr const char* name = "double";
+      static constexpr double null_value = std::numeric_limits<double>::max();
+      static auto make(const std::size_t i) -> double { return static_cast<double>(i) * 0.5; }
+      static auto to_number(const double value) -> std::uint64_t { return static_cast<std::uint64_t>(value); }
+      using conversion_source = float;
+      static constexpr float conversion_null_value = std::numeric_limits<float>::max();
+   };
+
+   template <>
+   struct value_traits<int*>
+   {
+      static constexpr const char* name = "int*";
+      static constexpr int* null_value = nullptr;
+      static auto make(const std::size_t i) -> int* { return &pointer_targets[i % element_count]; }
+      static auto to_number(const int* value) -> std::uint64_t { return reinterpret_cast<std::uintptr_t>(value); }
+   };
+
+   template <>
+   struct value_traits<io::one_value>
+   {
+      static constexpr const char* name = "one_value";
+      static constexpr io::one_value null_value{};
+      static auto make(const std::size_t i) -> io::one_value { return io::one_value(static_cast<int>(i) + 1); }
+      static auto to_number(const io::one_value& value) -> std::uint64_t { return static_cast<std::uint64_t>(value.a); }
+      using conversion_source = int;
+      static constexpr int conversion_null_value = -1;
+   };
+
+   template <>
+   struct value_traits<io::two_values>
+   {
+      static constexpr const char* name = "two_values";
+      static constexpr io::two_values null_value{};
+      static auto make(const std::size_t i) -> io::two_values { return io::two_values(static_cast<int>(i) + 1, static_cast<int>(i)); }
+      static auto to_number(const io::two_values& value) -> std::uint64_t { return static_cast<std::uint64_t>(value.m_a + value.m_b); }
+   };
+
+
+   // The two optional families side by side
+   template <typename T>
+   struct intrusive_family
+   {
+      static constexpr const char* name = "intrusive_optional";
+      using type = io::intrusive_optional<value_traits<T>::null_value>;
+   };
+
+   template <typename T>
+   struct std_family
+   {
+      static constexpr const char* name = "std::optional";
+      using type = std::optional<T>;
+   };
+
+
+   template <typename T>
+   concept has_conversion_source = requires { typename value_traits<T>::conversion_source; };
+
+   template <typename T, template <typename> typename family>
+   struct conversion_source_optional;
+
+   template <typename T>
+   struct conversion_source_optional<T, intrusive_family>
+   {
+      using type = io::intrusive_optional<value_traits<T>::conversion_null_value>;
+   };
+
+   template <typename T>
+   struct conversion_source_optional<T, std_family>
+   {
+      using type = std::optional<typename value_traits<T>::conversion_source>;
+   };
+
+
+   template <typename opt_type, typename T>
+   auto make_column(const bool with_nulls) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (with_nulls == false || is_null_element(i) == false)
+         {
+            result[i].emplace(value_traits<T>::make(i));
+         }
+      }
+      return result;
+   }
+
+
+   template <typename T, template <typename> typename family>
+   auto bench_family(io::bench::suite& suite) -> void
+   {
+      using opt_type = typename family<T>::type;
+      using traits = value_traits<T>;
+      const std::string type_name = traits::name;
+      const std::string family_name = family<T>::name;
+      constexpr std::uint64_t column_bytes = element_count * sizeof(opt_type);
+
+      std::vector<T> values;
+      values.reserve(element_count);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         values.push_back(traits::make(i));
+      }
+      const std::vector<opt_type> mixed = make_column<opt_type, T>(true);
+      std::vector<opt_type> target = make_column<opt_type, T>(true);
+
+      const auto run = [&](const std::string& workload, const std::uint64_t bytes, auto&& fn)
+      {
+         suite.run(workload, type_name, family_name, element_count, bytes, fn);
+      };
+
+      run("construction", column_bytes + element_count * sizeof(T), [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            std::destroy_at(&target[i]);
+            std::construct_at(&target[i], values[i]);
+         }
+         io::bench::do_not_optimize(target);
+      });
+
+      run("has_value", column_bytes, [&]()
+      {
+         std::size_t count = 0;
+         for (const opt_type& element : mixed)
+         {
+            count += element.has_value() ? 1 : 0;
+         }
+         io::bench::do_not_optimize(count);
+      });
+
+      run("value_or", column_bytes, [&]()
+      {
+         std::uint64_t sum = 0;
+         const T fallback = traits::make(1);
+         for (const opt_type& element : mixed)
+         {
+            sum += traits::to_number(element.value_or(fallback));
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      target = mixed;
+      run("swap", column_bytes, [&]()
+      {
+         for (std::size_t i = 0; i + 1 < element_count; i += 2)
+         {
+            target[i].swap(target[i + 1]);
+         }
+         io::bench::do_not_optimize(target);
+      });
+
+      run("emplace", column_bytes + element_count * sizeof(T), [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            target[i].emplace(values[i]);
+         }
+         io::bench::do_not_optimize(target);
+      });
+
+      run("assignment (2)", 2 * column_bytes, [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            target[i] = mixed[i];
+         }
+         io::bench::do_not_optimize(target);
+      });
+
+      std::vector<opt_type> source = mixed;
+      run("assignment (3)", 2 * column_bytes, [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            target[i] = std::move(source[i]);
+         }
+         io::bench::do_not_optimize(target);
+      });
+
+      run("assignment (4)", column_bytes + element_count * sizeof(T), [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            target[i] = values[i];
+         }
+         io::bench::do_not_optimize(target);
+      });
+
+      if constexpr (has_conversion_source<T>)
+      {
+         using source_type = typename conversion_source_optional<T, family>::type;
+         using source_value_type = typename value_traits<T>::conversion_source;
+         std::vector<source_type> converted(element_count);
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            if (is_null_element(i) == false)
+               converted[i].emplace(static_cast<source_value_type>(i % 1000));
+         }
+         const std::uint64_t bytes = column_bytes + element_count * sizeof(source_type);
+
+         run("assignment (5)", bytes, [&]()
+         {
+            for (std::size_t i = 0; i < element_count; ++i)
+            {
+               target[i] = converted[i];
+            }
+            io::bench::do_not_optimize(target);
+         });
+
+         run("assignment (6)", bytes, [&]()
+         {
+            for (std::size_t i = 0; i < element_count; ++i)
+            {
+               target[i] = std::move(converted[i]);
+            }
+            io::bench::do_not_optimize(target);
+         });
+      }
+
+      if constexpr (requires(const opt_type& element) { std::hash<opt_type>{}(element); })
+      {
+         run("hash", column_bytes, [&]()
+         {
+            std::size_t combined = 0;
+            for (const opt_type& element : mixed)
+            {
+               combined ^= std::hash<opt_type>{}(element);
+            }
+            io::bench::do_not_optimize(combined);
+         });
+
+         run("unordered_set insert", column_bytes, [&]()
+         {
+            std::unordered_set<opt_type> set;
+            for (const opt_type& element : mixed)
+            {
+               set.insert(element);
+            }
+            io::bench::do_not_optimize(set);
+         });
+      }
+
+      run("vector growth", column_bytes, [&]()
+      {
+         std::vector<opt_type> grown;
+         for (const opt_type& element : mixed)
+         {
+            grown.push_back(element);
+         }
+         io::bench::do_not_optimize(grown);
+      });
+
+      if constexpr (requires(const opt_type& element) { bool(element < element); })
+      {
+         run("sort", column_bytes, [&]()
+         {
+            target = mixed;
+            std::sort(target.begin(), target.end());
+            io::bench::do_not_optimize(target);
+         });
+      }
+   }
+
+
+   template <typename T>
+   auto bench_type(io::bench::suite& suite) -> void
+   {
+      bench_family<T, intrusive_family>(suite);
+      bench_family<T, std_family>(suite);
+   }
+
+} // namespace {}
+
+
+auto io::bench_optionals(io::bench::suite& suite) -> void
+{
+   bench_type<int>(suite);
+   bench_type<double>(suite);
+   bench_type<int*>(suite);
+   bench_type<io::one_value>(suite);
+   bench_type<io::two_values>(suite);
+}
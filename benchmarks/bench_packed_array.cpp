@@ -0,0 +1,88 @@
+#include "bench_packed_array.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_algorithms.h"
+#include "../intrusive_optional_packed_array.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 20;
+
+   // Enum-like column with 20 distinct values and 10% nulls. The bytes are the size of each layout.
+   auto bench_packed(io::bench::suite& suite) -> void
+   {
+      using array_type = io::packed_optional_array<5>;
+      using opt_type = array_type::optional_type;
+
+      std::vector<opt_type> column(element_count);
+      std::mt19937 generator(42);
+      for (opt_type& opt : column)
+      {
+         if (generator() % 10 != 0)
+            *opt = static_cast<std::uint8_t>(generator() % 20);
+      }
+      array_type packed(element_count);
+      packed.pack(0, column);
+      std::vector<opt_type> output(element_count);
+      std::vector<opt_type> block(1024);
+
+      const std::uint64_t packed_bytes = packed.size_in_bytes();
+      const std::uint64_t column_bytes = element_count * sizeof(opt_type);
+
+      suite.run("small domain count_null", "5-bit code", "packed_optional_array", element_count, packed_bytes, [&]()
+      {
+         io::bench::do_not_optimize(packed.count_null());
+      });
+      suite.run("small domain count_null", "5-bit code", "intrusive_optional<uint8_t>", element_count, column_bytes, [&]()
+      {
+         io::bench::do_not_optimize(io::count_null(column));
+      });
+
+      suite.run("small domain sum of engaged", "5-bit code", "packed_optional_array", element_count, packed_bytes, [&]()
+      {
+         // Unpacks blocks that stay in the L1 cache
+         std::size_t sum = 0;
+         for (std::size_t first = 0; first < element_count; first += block.size())
+         {
+            packed.unpack(first, block);
+            for (const opt_type& opt : block)
+            {
+               sum += opt.value_or(0);
+            }
+         }
+         io::bench::do_not_optimize(sum);
+      });
+      suite.run("small domain sum of engaged", "5-bit code", "intrusive_optional<uint8_t>", element_count, column_bytes, [&]()
+      {
+         std::size_t sum = 0;
+         for (const opt_type& opt : column)
+         {
+            sum += opt.value_or(0);
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      suite.run("small domain unpack", "5-bit code", "packed_optional_array", element_count, packed_bytes + column_bytes, [&]()
+      {
+         packed.unpack(0, output);
+         io::bench::do_not_optimize(output);
+      });
+      suite.run("small domain pack", "5-bit code", "packed_optional_array", element_count, packed_bytes + column_bytes, [&]()
+      {
+         packed.pack(0, column);
+         io::bench::do_not_optimize(packed);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_packed_array(io::bench::suite& suite) -> void
+{
+   bench_packed(suite);
+}
@@ -0,0 +1,101 @@
+#include "bench_padding.h"
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_padding.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 18;
+
+   struct int_char
+   {
+      std::int32_t i;
+      char c;
+   };
+
+   struct double_byte
+   {
+      double d;
+      std::uint8_t u;
+   };
+
+   auto make_value(int_char*, const std::size_t i) -> int_char
+   {
+      return { static_cast<std::int32_t>(i), 'x' };
+   }
+
+   auto make_value(double_byte*, const std::size_t i) -> double_byte
+   {
+      return { static_cast<double>(i), 1 };
+   }
+
+   auto key(const int_char& value) -> double
+   {
+      return value.i;
+   }
+
+   auto key(const double_byte& value) -> double
+   {
+      return value.d;
+   }
+
+
+   // The scans read the whole array, so the element size decides the memory traffic
+   template <typename opt_type, typename value_type>
+   auto bench_type(io::bench::suite& suite, const std::string& value_type_name, const std::string& optional_name) -> void
+   {
+      std::vector<opt_type> column(element_count);
+      std::mt19937 generator(42);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (generator() % 2 == 0)
+         {
+            column[i] = make_value(static_cast<value_type*>(nullptr), i);
+         }
+      }
+      constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+      suite.run("padded struct has_value", value_type_name, optional_name, element_count, bytes, [&]()
+      {
+         std::size_t count = 0;
+         for (const opt_type& element : column)
+         {
+            count += element.has_value() ? 1 : 0;
+         }
+         io::bench::do_not_optimize(count);
+      });
+
+      suite.run("padded struct sum of engaged", value_type_name, optional_name, element_count, bytes, [&]()
+      {
+         double sum = 0.0;
+         for (const opt_type& element : column)
+         {
+            if (element.has_value())
+               sum += key(*element);
+         }
+         io::bench::do_not_optimize(sum);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_padding(io::bench::suite& suite) -> void
+{
+   using int_char_padding = io::padding_optional<int_char, offsetof(int_char, c) + sizeof(char)>;
+   using double_byte_padding = io::padding_optional<double_byte, offsetof(double_byte, u) + sizeof(std::uint8_t)>;
+   static_assert(sizeof(int_char_padding) == 8 && sizeof(std::optional<int_char>) == 12);
+   static_assert(sizeof(double_byte_padding) == 16 && sizeof(std::optional<double_byte>) == 24);
+
+   bench_type<int_char_padding, int_char>(suite, "int32+char", "padding_optional");
+   bench_type<std::optional<int_char>, int_char>(suite, "int32+char", "std::optional");
+   bench_type<double_byte_padding, double_byte>(suite, "double+uint8", "padding_optional");
+   bench_type<std::optional<double_byte>, double_byte>(suite, "double+uint8", "std::optional");
+}
@@ -0,0 +1,100 @@
+#include "bench_relocation.h"
+
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../intrusive_optional.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+
+
+   // Growth by doubling, like std::vector, with the relocation step as parameter
+   template <typename opt_type, typename relocate_type>
+   auto grow(const relocate_type& relocate) -> std::size_t
+   {
+      std::allocator<opt_type> allocator;
+      std::size_t capacity = 1;
+      std::size_t size = 0;
+      opt_type* data = allocator.allocate(capacity);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (size == capacity)
+         {
+            opt_type* grown = allocator.allocate(capacity * 2);
+            relocate(data, data + size, grown);
+            allocator.deallocate(data, capacity);
+            data = grown;
+            capacity *= 2;
+         }
+         std::construct_at(data + size, static_cast<typename opt_type::value_type>(i));
+         ++size;
+      }
+      io::bench::do_not_optimize(data);
+      std::destroy_n(data, size);
+      allocator.deallocate(data, capacity);
+      return size;
+   }
+
+
+   template <typename opt_type>
+   auto bench_type(io::bench::suite& suite, const std::string& type_name) -> void
+   {
+      constexpr std::uint64_t column_bytes = element_count * sizeof(opt_type);
+
+      suite.run("growth (uninitialized_relocate)", type_name, "intrusive_optional", element_count, 2 * column_bytes, [&]()
+      {
+         grow<opt_type>([](opt_type* first, opt_type* last, opt_type* target) { io::uninitialized_relocate(first, last, target); });
+      });
+
+      suite.run("growth (move and destroy)", type_name, "intrusive_optional", element_count, 2 * column_bytes, [&]()
+      {
+         grow<opt_type>([](opt_type* first, opt_type* last, opt_type* target)
+         {
+            for (; first != last; ++first, ++target)
+            {
+               std::construct_at(target, std::move(*first));
+               std::destroy_at(first);
+            }
+         });
+      });
+
+      std::vector<opt_type> column(element_count);
+      for (std::size_t i = 0; i < element_count; i += 3)
+      {
+         column[i].emplace(static_cast<typename opt_type::value_type>(i));
+      }
+
+      suite.run("std::swap", type_name, "intrusive_optional", element_count / 2, column_bytes, [&]()
+      {
+         for (std::size_t i = 0; i + 1 < element_count; i += 2)
+         {
+            std::swap(column[i], column[i + 1]);
+         }
+         io::bench::do_not_optimize(column);
+      });
+
+      suite.run("member swap", type_name, "intrusive_optional", element_count / 2, column_bytes, [&]()
+      {
+         for (std::size_t i = 0; i + 1 < element_count; i += 2)
+         {
+            column[i].swap(column[i + 1]);
+         }
+         io::bench::do_not_optimize(column);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_relocation(io::bench::suite& suite) -> void
+{
+   bench_type<io::intrusive_optional<-1>>(suite, "int");
+   bench_type<io::intrusive_optional<std::numeric_limits<double>::max()>>(suite, "double");
+}
@@ -0,0 +1,160 @@
+#include "bench_slot_map.h"
+
+#include <limits>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_slot_map.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+   using map_type = io::slot_map<std::numeric_limits<std::uint64_t>::max()>;
+   using handle = io::slot_handle;
+
+
+   // The design slot_map replaces: std::optional slots with the same generations and free list
+   class std_slot_map
+   {
+      std::vector<std::optional<std::uint64_t>> m_slots;
+      std::vector<std::uint32_t> m_generations;
+      std::vector<std::uint32_t> m_free_slots;
+
+   public:
+      auto insert(const std::uint64_t value) -> handle
+      {
+         if (m_free_slots.empty())
+         {
+            m_slots.emplace_back(value);
+            m_generations.push_back(1);
+            return handle(static_cast<std::uint32_t>(m_slots.size() - 1), 1);
+         }
+         const std::uint32_t index = m_free_slots.back();
+         m_free_slots.pop_back();
+         m_slots[index].emplace(value);
+         return handle(index, m_generations[index]);
+      }
+
+      auto erase(const handle h) -> bool
+      {
+         const std::uint32_t index = h.index();
+         if (index >= m_slots.size() || m_generations[index] != h.generation() || m_slots[index].has_value() == false)
+         {
+            return false;
+         }
+         m_slots[index].reset();
+         ++m_generations[index];
+         m_free_slots.push_back(index);
+         return true;
+      }
+
+      [[nodiscard]] auto find(const handle h) const -> const std::uint64_t*
+      {
+         const std::uint32_t index = h.index();
+         if (index >= m_slots.size() || m_generations[index] != h.generation() || m_slots[index].has_value() == false)
+         {
+            return nullptr;
+         }
+         return &*m_slots[index];
+      }
+
+      template <typename fn_type>
+      auto for_each_value(fn_type&& fn) const -> void
+      {
+         for (const std::optional<std::uint64_t>& slot : m_slots)
+         {
+            if (slot.has_value())
+               fn(*slot);
+         }
+      }
+   };
+
+
+   template <typename map_t>
+   auto bench_map(io::bench::suite& suite, const std::string& optional_name) -> void
+   {
+      std::vector<std::size_t> order(element_count);
+      std::mt19937 generator(42);
+      for (std::size_t& index : order)
+      {
+         index = generator() % element_count;
+      }
+
+      const auto run = [&](const std::string& workload, const std::uint64_t bytes, auto&& fn)
+      {
+         suite.run(workload, "uint64_t", optional_name, element_count, bytes, fn);
+      };
+
+      run("slot map insert", element_count * sizeof(std::uint64_t), [&]()
+      {
+         map_t map;
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            io::bench::do_not_optimize(map.insert(i));
+         }
+      });
+
+      // A map with roughly 60% free slots after random erases
+      map_t map;
+      std::vector<handle> handles;
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         handles.push_back(map.insert(i));
+      }
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         map.erase(handles[order[i]]);
+      }
+
+      run("slot map lookup", element_count * sizeof(std::uint64_t), [&]()
+      {
+         std::uint64_t sum = 0;
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            const std::uint64_t* value = map.find(handles[order[i]]);
+            sum += value != nullptr ? *value : 0;
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      run("slot map churn", element_count * sizeof(std::uint64_t), [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            handle& h = handles[order[i]];
+            if (map.erase(h) == false)
+               h = map.insert(i);
+         }
+         io::bench::do_not_optimize(handles);
+      });
+
+      run("slot map iteration", element_count * sizeof(std::uint64_t), [&]()
+      {
+         std::uint64_t sum = 0;
+         if constexpr (std::is_same_v<map_t, std_slot_map>)
+         {
+            map.for_each_value([&](const std::uint64_t value) { sum += value; });
+         }
+         else
+         {
+            for (const std::uint64_t value : map.values())
+            {
+               sum += value;
+            }
+         }
+         io::bench::do_not_optimize(sum);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_slot_map(io::bench::suite& suite) -> void
+{
+   bench_map<map_type>(suite, "intrusive_optional");
+   bench_map<std_slot_map>(suite, "std::optional");
+}
@@ -0,0 +1,150 @@
+#include "bench_static_map.h"
+
+#include <random>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "../intrusive_optional_static_map.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+
+   constexpr std::pair<std::string_view, int> keyword_entries[] = {
+      { "alignas", 0 }, { "alignof", 1 }, { "auto", 2 }, { "bool", 3 }, { "break", 4 }, { "case", 5 },
+      { "catch", 6 }, { "char", 7 }, { "class", 8 }, { "const", 9 }, { "constexpr", 10 }, { "continue", 11 },
+      { "decltype", 12 }, { "default", 13 }, { "delete", 14 }, { "do", 15 }, { "double", 16 }, { "else", 17 },
+      { "enum", 18 }, { "explicit", 19 }, { "extern", 20 }, { "false", 21 }, { "float", 22 }, { "for", 23 },
+      { "friend", 24 }, { "goto", 25 }, { "if", 26 }, { "inline", 27 }, { "int", 28 }, { "long", 29 },
+      { "mutable", 30 }, { "namespace", 31 }, { "new", 32 }, { "noexcept", 33 }, { "nullptr", 34 }, { "operator", 35 },
+      { "private", 36 }, { "protected", 37 }, { "public", 38 }, { "return", 39 }, { "short", 40 }, { "signed", 41 },
+      { "sizeof", 42 }, { "static", 43 }, { "struct", 44 }, { "switch", 45 }, { "template", 46 }, { "this", 47 },
+      { "throw", 48 }, { "true", 49 }, { "try", 50 }, { "typedef", 51 }, { "typename", 52 }, { "union", 53 },
+      { "unsigned", 54 }, { "using", 55 }, { "virtual", 56 }, { "void", 57 }, { "volatile", 58 }, { "while", 59 }
+   };
+   constexpr auto keywords = io::make_static_map<-1>(keyword_entries);
+
+
+   // Sparse opcodes, the classic case for a switch
+   constexpr std::pair<std::uint32_t, int> opcode_entries[] = {
+      { 0x01, 1 }, { 0x07, 2 }, { 0x10, 3 }, { 0x13, 4 }, { 0x1f, 5 }, { 0x22, 6 }, { 0x37, 7 }, { 0x41, 8 },
+      { 0x4c, 9 }, { 0x58, 10 }, { 0x63, 11 }, { 0x6f, 12 }, { 0x80, 13 }, { 0x91, 14 }, { 0xa4, 15 }, { 0xb0, 16 },
+      { 0xbb, 17 }, { 0xc9, 18 }, { 0xd2, 19 }, { 0xe0, 20 }, { 0xea, 21 }, { 0xf1, 22 }, { 0xfc, 23 }, { 0xff, 24 }
+   };
+   constexpr auto opcodes = io::make_static_map<-1>(opcode_entries);
+
+   auto opcode_switch(const std::uint32_t opcode) -> int
+   {
+      switch (opcode)
+      {
+      case 0x01: return 1;
+      case 0x07: return 2;
+      case 0x10: return 3;
+      case 0x13: return 4;
+      case 0x1f: return 5;
+      case 0x22: return 6;
+      case 0x37: return 7;
+      case 0x41: return 8;
+      case 0x4c: return 9;
+      case 0x58: return 10;
+      case 0x63: return 11;
+      case 0x6f: return 12;
+      case 0x80: return 13;
+      case 0x91: return 14;
+      case 0xa4: return 15;
+      case 0xb0: return 16;
+      case 0xbb: return 17;
+      case 0xc9: return 18;
+      case 0xd2: return 19;
+      case 0xe0: return 20;
+      case 0xea: return 21;
+      case 0xf1: return 22;
+      case 0xfc: return 23;
+      case 0xff: return 24;
+      default: return -1;
+      }
+   }
+
+} // namespace {}
+
+
+auto io::bench_static_map(io::bench::suite& suite) -> void
+{
+   std::mt19937 generator(42);
+
+   // Three quarters of the lookups hit
+   std::vector<std::string> words(element_count);
+   for (std::string& word : words)
+   {
+      word = std::string(keyword_entries[generator() % std::size(keyword_entries)].first);
+      if (generator() % 4 == 0)
+         word += "_";
+   }
+   const std::unordered_map<std::string_view, int> keyword_map(std::begin(keyword_entries), std::end(keyword_entries));
+   constexpr std::uint64_t word_bytes = element_count * sizeof(std::string);
+
+   suite.run("keyword lookup", "int", "static_map", element_count, word_bytes, [&]()
+   {
+      int sum = 0;
+      for (const std::string& word : words)
+      {
+         sum += keywords.find(word).value_or(0);
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   suite.run("keyword lookup", "int", "std::unordered_map", element_count, word_bytes, [&]()
+   {
+      int sum = 0;
+      for (const std::string& word : words)
+      {
+         const auto it = keyword_map.find(word);
+         sum += it != keyword_map.end() ? it->second : 0;
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   std::vector<std::uint32_t> codes(element_count);
+   for (std::uint32_t& code : codes)
+   {
+      code = generator() % 256;
+   }
+   const std::unordered_map<std::uint32_t, int> opcode_map(std::begin(opcode_entries), std::end(opcode_entries));
+   constexpr std::uint64_t code_bytes = element_count * sizeof(std::uint32_t);
+
+   suite.run("opcode lookup", "int", "static_map", element_count, code_bytes, [&]()
+   {
+      int sum = 0;
+      for (const std::uint32_t code : codes)
+      {
+         sum += opcodes.find(code).value_or(0);
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   suite.run("opcode lookup", "int", "std::unordered_map", element_count, code_bytes, [&]()
+   {
+      int sum = 0;
+      for (const std::uint32_t code : codes)
+      {
+         const auto it = opcode_map.find(code);
+         sum += it != opcode_map.end() ? it->second : 0;
+      }
+      io::bench::do_not_optimize(sum);
+   });
+
+   suite.run("opcode lookup", "int", "switch", element_count, code_bytes, [&]()
+   {
+      int sum = 0;
+      for (const std::uint32_t code : codes)
+      {
+         const int value = opcode_switch(code);
+         sum += value != -1 ? value : 0;
+      }
+      io::bench::do_not_optimize(sum);
+   });
+}
@@ -0,0 +1,139 @@
+#include "bench_swap.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_algorithms.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+
+
+   // The member swap before the trivially copyable fast path, for reference
+   template <typename opt_type>
+   auto branchy_swap(opt_type& first, opt_type& second) -> void
+   {
+      if (first.has_value() == false && second.has_value() == false)
+         return;
+      if (first.has_value() && second.has_value())
+      {
+         std::swap(*first, *second);
+         return;
+      }
+      opt_type& source = first.has_value() ? first : second;
+      opt_type& target = first.has_value() ? second : first;
+      target.emplace(*source);
+      source.reset();
+   }
+
+
+   template <typename opt_type>
+   auto make_column() -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      std::mt19937 generator(42);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (generator() % 2 == 0)
+            result[i].emplace(static_cast<typename opt_type::value_type>(i));
+      }
+      return result;
+   }
+
+
+   template <typename opt_type>
+   auto bench_type(io::bench::suite& suite, const std::string& type_name) -> void
+   {
+      constexpr std::uint64_t column_bytes = element_count * sizeof(opt_type);
+      std::vector<opt_type> column = make_column<opt_type>();
+      std::vector<opt_type> other = make_column<opt_type>();
+
+      std::vector<std::size_t> permutation(element_count);
+      std::iota(permutation.begin(), permutation.end(), std::size_t{ 0 });
+      std::shuffle(permutation.begin(), permutation.end(), std::mt19937(7));
+
+      // Fisher-Yates with precomputed targets so only the swaps are measured
+      const auto shuffle_with = [&](auto&& swap_fn)
+      {
+         for (std::size_t i = element_count - 1; i > 0; --i)
+         {
+            swap_fn(column[i], column[permutation[i] % (i + 1)]);
+         }
+         io::bench::do_not_optimize(column);
+      };
+
+      suite.run("shuffle (member swap)", type_name, "intrusive_optional", element_count, column_bytes, [&]()
+      {
+         shuffle_with([](opt_type& a, opt_type& b) { a.swap(b); });
+      });
+      suite.run("shuffle (branchy swap)", type_name, "intrusive_optional", element_count, column_bytes, [&]()
+      {
+         shuffle_with([](opt_type& a, opt_type& b) { branchy_swap(a, b); });
+      });
+
+      // Applies the permutation in place by following its cycles
+      const auto permute_with = [&](auto&& swap_fn)
+      {
+         std::vector<bool> done(element_count, false);
+         for (std::size_t start = 0; start < element_count; ++start)
+         {
+            for (std::size_t i = start; done[permutation[i]] == false && permutation[i] != start; i = permutation[i])
+            {
+               swap_fn(column[i], column[permutation[i]]);
+               done[i] = true;
+            }
+            done[start] = true;
+         }
+         io::bench::do_not_optimize(column);
+      };
+
+      suite.run("permutation (member swap)", type_name, "intrusive_optional", element_count, column_bytes, [&]()
+      {
+         permute_with([](opt_type& a, opt_type& b) { a.swap(b); });
+      });
+      suite.run("permutation (branchy swap)", type_name, "intrusive_optional", element_count, column_bytes, [&]()
+      {
+         permute_with([](opt_type& a, opt_type& b) { branchy_swap(a, b); });
+      });
+
+      suite.run("swap_ranges", type_name, "intrusive_optional", element_count, 2 * column_bytes, [&]()
+      {
+         io::swap_ranges(column, other);
+         io::bench::do_not_optimize(column);
+      });
+      suite.run("swap_ranges (branchy swap loop)", type_name, "intrusive_optional", element_count, 2 * column_bytes, [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            branchy_swap(column[i], other[i]);
+         }
+         io::bench::do_not_optimize(column);
+      });
+
+      suite.run("rotate", type_name, "intrusive_optional", element_count, column_bytes, [&]()
+      {
+         io::rotate(column, element_count / 3);
+         io::bench::do_not_optimize(column);
+      });
+      suite.run("std::rotate", type_name, "intrusive_optional", element_count, column_bytes, [&]()
+      {
+         std::rotate(column.begin(), column.begin() + element_count / 3, column.end());
+         io::bench::do_not_optimize(column);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_swap(io::bench::suite& suite) -> void
+{
+   bench_type<io::intrusive_optional<-1>>(suite, "int");
+   bench_type<io::intrusive_optional<std::numeric_limits<double>::max()>>(suite, "double");
+}
@@ -0,0 +1,92 @@
+#include "bench_tagged_ptr.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_tagged_ptr.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 18;
+
+   // List node with the flags in the next pointer
+   struct tagged_node
+   {
+      io::tagged_optional_ptr<tagged_node, 3> next;
+      std::int64_t payload = 0;
+
+      auto get_next() const -> const tagged_node* { return next.get(); }
+      auto is_marked() const -> bool { return next.flag(0); }
+      auto link(tagged_node* target, const bool marked) -> void { next = { target, marked ? 1u : 0u }; }
+   };
+
+   // List node with a separate flags field
+   struct flags_node
+   {
+      flags_node* next = nullptr;
+      std::uint8_t flags = 0;
+      std::int64_t payload = 0;
+
+      auto get_next() const -> const flags_node* { return next; }
+      auto is_marked() const -> bool { return (flags & 1) != 0; }
+      auto link(flags_node* target, const bool marked) -> void { next = target; flags = marked ? 1 : 0; }
+   };
+
+   static_assert(sizeof(tagged_node) == 16);
+   static_assert(sizeof(flags_node) == 24);
+
+
+   // Links the nodes in random order, so that following the list jumps around in memory
+   template <typename node_type>
+   auto bench_type(io::bench::suite& suite, const std::string& value_type_name, const std::string& optional_name) -> void
+   {
+      std::vector<node_type> nodes(element_count);
+      std::vector<std::size_t> order(element_count);
+      std::iota(order.begin(), order.end(), std::size_t{ 0 });
+      std::mt19937 generator(42);
+      std::shuffle(order.begin() + 1, order.end(), generator);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         node_type& node = nodes[order[i]];
+         node.payload = static_cast<std::int64_t>(i);
+         node_type* next = i + 1 < element_count ? &nodes[order[i + 1]] : nullptr;
+         node.link(next, generator() % 2 == 0);
+      }
+      constexpr std::uint64_t bytes = element_count * sizeof(node_type);
+
+      suite.run("list walk sum of marked", value_type_name, optional_name, element_count, bytes, [&]()
+      {
+         std::int64_t sum = 0;
+         for (const node_type* node = &nodes[order[0]]; node != nullptr; node = node->get_next())
+         {
+            if (node->is_marked())
+               sum += node->payload;
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      suite.run("node array count marked", value_type_name, optional_name, element_count, bytes, [&]()
+      {
+         std::size_t count = 0;
+         for (const node_type& node : nodes)
+         {
+            count += node.is_marked() ? 1 : 0;
+         }
+         io::bench::do_not_optimize(count);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_tagged_ptr(io::bench::suite& suite) -> void
+{
+   bench_type<tagged_node>(suite, "list node", "tagged_optional_ptr");
+   bench_type<flags_node>(suite, "list node", "pointer+flags");
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+#include "bench_common.h"
+
+namespace io {
+   auto bench_tagged_ptr(bench::suite& suite) -> void;
+}
@@ -0,0 +1,61 @@
+#include "bench_telemetry.h"
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_telemetry.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 18;
+
+
+   // Cost of the hooks: Without telemetry the loops are the plain ones, with counting_telemetry
+   // every call adds to a thread_local counter
+   template <typename opt_type>
+   auto bench_policy(io::bench::suite& suite, const std::string& optional_name) -> void
+   {
+      std::vector<opt_type> column(element_count);
+      std::mt19937 generator(42);
+      for (opt_type& element : column)
+      {
+         const std::int32_t value = static_cast<std::int32_t>(generator() % 1000);
+         if (value >= 100)
+         {
+            element = value;
+         }
+      }
+      constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+      suite.run("telemetry has_value count", "int32", optional_name, element_count, bytes, [&]()
+      {
+         std::size_t count = 0;
+         for (const opt_type& element : column)
+         {
+            count += element.has_value() ? 1 : 0;
+         }
+         io::bench::do_not_optimize(count);
+      });
+
+      suite.run("telemetry checked assignment", "int32", optional_name, element_count, bytes, [&]()
+      {
+         for (std::size_t i = 0; i < element_count; ++i)
+         {
+            column[i] = static_cast<std::int32_t>(i & 1023);
+         }
+         io::bench::do_not_optimize(column.data());
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_telemetry(io::bench::suite& suite) -> void
+{
+   bench_policy<io::intrusive_optional<std::int32_t{ -1 }>>(suite, "no_telemetry");
+   bench_policy<io::intrusive_optional<std::int32_t{ -1 }, io::safety_mode_t::unsafe, io::counting_telemetry>>(suite, "counting_telemetry");
+}
@@ -0,0 +1,89 @@
+#include "bench_views.h"
+
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_views.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 16;
+   using opt_type = io::intrusive_optional<-1>;
+
+
+   // Independent nulls with the given probability. Only sparse columns have whole null blocks.
+   auto make_column(const double null_fraction) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      std::mt19937 generator(42);
+      std::bernoulli_distribution is_null(null_fraction);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (is_null(generator) == false)
+            result[i].emplace(static_cast<int>(generator() % 1000));
+      }
+      return result;
+   }
+
+
+   auto bench_density(io::bench::suite& suite, const double null_fraction) -> void
+   {
+      const std::vector<opt_type> column = make_column(null_fraction);
+      const std::string suffix = " (" + std::to_string(static_cast<int>(null_fraction * 100)) + "% null)";
+      constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+      suite.run("views::engaged" + suffix, "int", "intrusive_optional", element_count, bytes, [&]()
+      {
+         std::uint64_t sum = 0;
+         for (const int value : column | io::views::engaged)
+         {
+            sum += static_cast<std::uint64_t>(value);
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      suite.run("std::views::filter" + suffix, "int", "intrusive_optional", element_count, bytes, [&]()
+      {
+         std::uint64_t sum = 0;
+         for (const opt_type& element : column | std::views::filter([](const opt_type& opt) { return opt.has_value(); }))
+         {
+            sum += static_cast<std::uint64_t>(*element);
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      suite.run("views::indices_engaged" + suffix, "int", "intrusive_optional", element_count, bytes, [&]()
+      {
+         std::uint64_t sum = 0;
+         for (const std::size_t i : column | io::views::indices_engaged)
+         {
+            sum += i;
+         }
+         io::bench::do_not_optimize(sum);
+      });
+
+      suite.run("views::values_or" + suffix, "int", "intrusive_optional", element_count, bytes, [&]()
+      {
+         std::uint64_t sum = 0;
+         for (const int value : column | io::views::values_or(0))
+         {
+            sum += static_cast<std::uint64_t>(value);
+         }
+         io::bench::do_not_optimize(sum);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_views(io::bench::suite& suite) -> void
+{
+   for (const double null_fraction : { 0.1, 0.5, 0.9, 0.99 })
+   {
+      bench_density(suite, null_fraction);
+   }
+}
@@ -0,0 +1,78 @@
+#include "bench_zone_map.h"
+
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../intrusive_optional_zone_map.h"
+
+
+namespace
+{
+
+   constexpr std::size_t element_count = 1 << 20;
+   using opt_type = io::intrusive_optional<std::numeric_limits<double>::max()>;
+
+
+   // A slowly rising series with noise and 10% nulls, so that neighbouring blocks have narrow and
+   // mostly disjoint ranges
+   auto make_column() -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(element_count);
+      std::mt19937 generator(42);
+      std::uniform_real_distribution<double> noise(0.0, 16.0);
+      for (std::size_t i = 0; i < element_count; ++i)
+      {
+         if (generator() % 10 != 0)
+            result[i].emplace(static_cast<double>(i) + noise(generator));
+      }
+      return result;
+   }
+
+
+   auto bench_selectivity(io::bench::suite& suite, std::vector<opt_type>& column, const io::zone_map<opt_type::null_value>& zones, const double selectivity) -> void
+   {
+      const double lo = static_cast<double>(element_count) * 0.25;
+      const double hi = lo + static_cast<double>(element_count) * selectivity;
+      const std::string suffix = " (" + std::to_string(selectivity * 100.0).substr(0, 4) + "% selected)";
+      constexpr std::uint64_t bytes = element_count * sizeof(opt_type);
+
+      suite.run("range scan" + suffix, "double", "zone_map::scan_where", element_count, bytes, [&]()
+      {
+         double sum = 0.0;
+         zones.scan_where(lo, hi, [&](std::size_t, const double value) { sum += value; });
+         io::bench::do_not_optimize(sum);
+      });
+
+      suite.run("range scan" + suffix, "double", "full scan with has_value()", element_count, bytes, [&]()
+      {
+         double sum = 0.0;
+         for (const opt_type& opt : column)
+         {
+            if (opt.has_value() && lo <= *opt && *opt <= hi)
+               sum += *opt;
+         }
+         io::bench::do_not_optimize(sum);
+      });
+   }
+
+} // namespace {}
+
+
+auto io::bench_zone_map(io::bench::suite& suite) -> void
+{
+   std::vector<opt_type> column = make_column();
+   const io::zone_map<opt_type::null_value> zones(column);
+   for (const double selectivity : { 0.001, 0.01, 0.1, 0.5 })
+   {
+      bench_selectivity(suite, column, zones, selectivity);
+   }
+
+   suite.run("zone map build", "double", "zone_map", element_count, element_count * sizeof(opt_type), [&]()
+   {
+      const io::zone_map<opt_type::null_value> rebuilt(column);
+      io::bench::do_not_optimize(rebuilt.zones().data());
+   });
+}
@@ -0,0 +1,73 @@
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "bench_optionals.h"
+#include "bench_codecs.h"
+#include "bench_zone_map.h"
+#include "bench_expressions.h"
+#include "bench_fill.h"
+#include "bench_join.h"
+#include "bench_relocation.h"
+#include "bench_swap.h"
+#include "bench_monadic.h"
+#include "bench_views.h"
+#include "bench_slot_map.h"
+#include "bench_gapped_array.h"
+#include "bench_static_map.h"
+#include "bench_by_member.h"
+#include "bench_padding.h"
+#include "bench_tagged_ptr.h"
+#include "bench_packed_array.h"
+#include "bench_convert.h"
+#include "bench_telemetry.h"
+#include "bench_failure.h"
+#include "bench_modify.h"
+
+
+// Usage: bench [--json <path>] [--repetitions <count>]
+int main(int argc, char* argv[])
+{
+   std::string json_path;
+   int repetitions = 5;
+   for (int i = 1; i + 1 < argc; i += 2)
+   {
+      const std::string argument = argv[i];
+      if (argument == "--json")
+         json_path = argv[i + 1];
+      else if (argument == "--repetitions")
+         repetitions = std::stoi(argv[i + 1]);
+   }
+
+   io::bench::suite suite(repetitions);
+   io::bench_optionals(suite);
+   io::bench_codecs(suite);
+   io::bench_zone_map(suite);
+   io::bench_expressions(suite);
+   io::bench_fill(suite);
+   io::bench_join(suite);
+   io::bench_relocation(suite);
+   io::bench_swap(suite);
+   io::bench_monadic(suite);
+   io::bench_views(suite);
+   io::bench_slot_map(suite);
+   io::bench_gapped_array(suite);
+   io::bench_static_map(suite);
+   io::bench_by_member(suite);
+   io::bench_padding(suite);
+   io::bench_tagged_ptr(suite);
+   io::bench_packed_array(suite);
+   io::bench_convert(suite);
+   io::bench_telemetry(suite);
+   io::bench_failure(suite);
+   io::bench_modify(suite);
+
+   suite.write_table(std::cout);
+   if (json_path.empty() == false)
+   {
+      std::ofstream file(json_path);
+      suite.write_json(file);
+   }
+
+   return 0;
+}
@@ -0,0 +1,64 @@
+// Instantiates IO_COMPILE_TIME_COUNT distinct intrusive_optionals and uses the members that
+// typical code touches: construction, copies, assignments, conversions between neighbouring
+// instantiations, comparisons and observers. Compiled with -fsyntax-only by measure_compile_time.cmake.
+#include <cstddef>
+#include <utility>
+
+#include "../../intrusive_optional.h"
+
+#ifndef IO_COMPILE_TIME_COUNT
+#define IO_COMPILE_TIME_COUNT 200
+#endif
+
+
+namespace
+{
+
+   template <int i>
+   struct sentinel_record
+   {
+      int id = i;
+      constexpr auto operator==(const sentinel_record&) const -> bool = default;
+   };
+
+
+   template <int i>
+   auto use_instance() -> int
+   {
+      using int_type = io::intrusive_optional<i>;
+      using next_type = io::intrusive_optional<i + 1>;
+      using long_type = io::intrusive_optional<static_cast<long long>(i)>;
+      using class_type = io::intrusive_optional<sentinel_record<i>{}>;
+
+      int_type a{ i + 2 };
+      int_type b = a;
+      b = a;
+      b = std::move(a);
+      b = i + 3;
+      const next_type c(b);
+      long_type d(c);
+      d = c;
+      class_type e;
+      e = sentinel_record<i>{ i + 1 };
+      const class_type f = e;
+
+      int result = b.value_or(0) + *c + static_cast<int>(d.value_or(0));
+      result += (b == c) + (b < c) + (b == i) + (b != std::nullopt) + (e == f);
+      result += b.has_value() + e.has_value() + static_cast<int>(b.get_std().has_value());
+      return result;
+   }
+
+
+   template <int... is>
+   auto use_instances(std::integer_sequence<int, is...>) -> int
+   {
+      return (use_instance<is * 2>() + ...);
+   }
+
+} // namespace {}
+
+
+auto compile_time_instances() -> int
+{
+   return use_instances(std::make_integer_sequence<int, IO_COMPILE_TIME_COUNT>{});
+}
@@ -0,0 +1,51 @@
+# Usage: cmake -DCOMPILER=<path> -DSOURCE=<path> [-DCOUNT=<n>] [-DRUNS=<n>] [-DFLAGS=<flags>] -P measure_compile_time.cmake
+#
+# Compiles SOURCE RUNS times with -fsyntax-only and IO_COMPILE_TIME_COUNT=COUNT and prints the
+# fastest run, which is the least disturbed by other load on the machine.
+
+foreach(variable COMPILER SOURCE)
+   if(NOT DEFINED ${variable})
+      message(FATAL_ERROR "${variable} is not set")
+   endif()
+endforeach()
+if(NOT DEFINED COUNT)
+   set(COUNT 200)
+endif()
+if(NOT DEFINED RUNS)
+   set(RUNS 3)
+endif()
+separate_arguments(flags UNIX_COMMAND "${FLAGS}")
+
+# Microseconds since the epoch. %f needs CMake 3.23, older versions measure whole seconds.
+function(io_now result)
+   # One timestamp, so that seconds and microseconds belong together
+   string(TIMESTAMP timestamp "%s %f" UTC)
+   string(REGEX MATCH "^([0-9]+) 0*([0-9]+)$" parts "${timestamp}")
+   if(parts)
+      math(EXPR now "${CMAKE_MATCH_1} * 1000000 + ${CMAKE_MATCH_2}")
+   else()
+      string(REGEX MATCH "^[0-9]+" seconds "${timestamp}")
+      math(EXPR now "${seconds} * 1000000")
+   endif()
+   set(${result} ${now} PARENT_SCOPE)
+endfunction()
+
+set(best "")
+foreach(run RANGE 1 ${RUNS})
+   io_now(begin)
+   execute_process(
+      COMMAND ${COMPILER} -std=c++20 -fsyntax-only ${flags} -DIO_COMPILE_TIME_COUNT=${COUNT} ${SOURCE}
+      RESULT_VARIABLE compile_result
+   )
+   io_now(end)
+   if(NOT compile_result EQUAL 0)
+      message(FATAL_ERROR "Compiling ${SOURCE} failed")
+   endif()
+   math(EXPR elapsed "(${end} - ${begin}) / 1000")
+   message(STATUS "Run ${run}: ${elapsed} ms")
+   if(best STREQUAL "" OR elapsed LESS best)
+      set(best ${elapsed})
+   endif()
+endforeach()
+
+message(STATUS "${COUNT} instantiation sets: ${best} ms (fastest of ${RUNS})")
@@ -0,0 +1,27 @@
+// Module interface unit for intrusive_optional.h: import io.intrusive_optional;
+// The standard headers go into the global module fragment, so the export block only contains the
+// declarations of the header. Translation units may include the header and import the module.
+module;
+
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+export module io.intrusive_optional;
+
+export
+{
+#include "intrusive_optional.h"
+}
@@ -1,11 +1,35 @@
 #pragma once
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <stdexcept>
 #include <tuple> // Should be free from <optional>
 #include <utility>
 
 
+// Checks of safety_mode_t::debug. By default on without NDEBUG and in sanitizer builds.
+#ifndef IO_DEBUG_CHECKS
+#  if !defined(NDEBUG) || defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#     define IO_DEBUG_CHECKS 1
+#  elif defined(__has_feature)
+#     if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer) || __has_feature(undefined_behavior_sanitizer)
+#        define IO_DEBUG_CHECKS 1
+#     endif
+#  endif
+#  ifndef IO_DEBUG_CHECKS
+#     define IO_DEBUG_CHECKS 0
+#  endif
+#endif
+
+
 namespace io
 {
 
@@ -16,18 +40,256 @@ namespace io
       }
    };
 
-   enum class safety_mode_t{unsafe, safe};
+   // unsafe: No checks. safe: Checks for unintentional nulls and no mutable access to the value.
+   // debug: The API of unsafe, with the checks of safe and checked operator* and operator-> where
+   // IO_DEBUG_CHECKS is 1. Otherwise it compiles to exactly the code of unsafe.
+   enum class safety_mode_t{unsafe, safe, debug};
+
+
+   // Declares that a member of a value_type doesn't take part in its comparison with the null_value,
+   // so that changing it can't make an optional null. modify<member>() then skips the check.
+   // template <> struct io::sentinel_independent_member<&record::payload> : std::true_type {};
+   template <auto member>
+   struct sentinel_independent_member : std::false_type {};
+
+   template <auto member>
+   constexpr inline bool sentinel_independent_member_v = sentinel_independent_member<member>::value;
+
+
+   // Failures of intrusive_optional members
+   enum class optional_errc
+   {
+      none,
+      bad_access,           // value() of a null optional
+      unintentionally_null, // A value equal to the null_value, see safety mode
+      capacity_exceeded     // A container of optionals, e.g. io::slot_map, is full
+   };
+
+   // Default failure policy: value() throws std::bad_optional_access, the safety mode checks
+   // throw io::unintentionally_null and full containers throw std::length_error. Without exception
+   // support, e.g. with -fno-exceptions, all of them abort. A failure policy is a type with a [[noreturn]] static fail(optional_errc), see
+   // intrusive_optional_failure.h for others.
+   struct throw_on_failure
+   {
+      [[noreturn]] static auto fail([[maybe_unused]] const optional_errc error) -> void
+      {
+#if __cpp_exceptions
+         if (error == optional_errc::bad_access)
+         {
+            throw std::bad_optional_access{};
+         }
+         if (error == optional_errc::capacity_exceeded)
+         {
+            throw std::length_error("The container of intrusive_optionals is full.");
+         }
+         throw unintentionally_null{};
+#else
+         std::abort();
+#endif
+      }
+   };
+
+
+   // Result of try_value(): Either a reference to the value or the error, like a
+   // std::expected<T&, optional_errc>
+   template <typename T>
+   class value_result
+   {
+      T* m_value = nullptr;
+      optional_errc m_error = optional_errc::none;
+
+   public:
+      constexpr value_result(T& value) noexcept
+         : m_value(std::addressof(value))
+      { }
+
+      constexpr value_result(const optional_errc error) noexcept
+         : m_error(error)
+      { }
+
+      [[nodiscard]] constexpr auto has_value() const noexcept -> bool
+      {
+         return m_value != nullptr;
+      }
+
+      explicit constexpr operator bool() const noexcept
+      {
+         return this->has_value();
+      }
+
+      constexpr auto operator*() const noexcept -> T&
+      {
+         return *m_value;
+      }
+
+      constexpr auto operator->() const noexcept -> T*
+      {
+         return m_value;
+      }
+
+      [[nodiscard]] constexpr auto error() const noexcept -> optional_errc
+      {
+         return m_error;
+      }
+   };
+
+
+   // Events reported to the telemetry policy of an intrusive_optional
+   enum class telemetry_event
+   {
+      value_observed,     // has_value() returned true
+      null_observed,      // has_value() returned false
+      sentinel_collision, // A value written into the optional was equal to the null_value
+      bad_access,         // value() threw std::bad_optional_access
+      reset               // reset() was called
+   };
+
+   // Default telemetry policy, records nothing. A policy has a static constexpr bool enabled and, if
+   // that's true, a static member function template record<optional_type>(telemetry_event) that
+   // doesn't throw. See intrusive_optional_telemetry.h for counters.
+   struct no_telemetry
+   {
+      static constexpr bool enabled = false;
+   };
+
+
+   // Sentinel that transform() uses for results of type T when no null value is given explicitly.
+   // Can be specialized for other types.
+   template <typename T>
+   struct default_null_value {};
+
+   template <typename T>
+   requires std::is_pointer_v<T>
+   struct default_null_value<T>
+   {
+      static constexpr T value = nullptr;
+   };
+
+   template <typename T>
+   requires (std::is_arithmetic_v<T> && std::is_same_v<T, bool> == false)
+   struct default_null_value<T>
+   {
+      static constexpr T value = std::numeric_limits<T>::max();
+   };
+
+   template <typename T>
+   concept has_default_null_value = requires { default_null_value<T>::value; };
+
+   namespace detail
+   {
+
+      // Constraints of the members as concepts of the value_type. The compiler caches the
+      // satisfaction of a concept per type, so all sentinels of the same value_type share it. Concept
+      // conjunctions and disjunctions also stop at the first trait that decides them, while && and ||
+      // in a bool constant instantiate every trait.
+
+      template <typename T>
+      concept trivially_copy_constructible_value = std::is_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<T>;
+
+      template <typename T>
+      concept nontrivially_copy_constructible_value = std::is_copy_constructible_v<T> && std::is_trivially_copy_constructible_v<T> == false;
+
+      template <typename T>
+      concept nontrivially_move_constructible_value = std::is_move_constructible_v<T> && std::is_trivially_move_constructible_v<T> == false;
+
+      template <typename T>
+      concept copy_assignable_value = std::is_copy_constructible_v<T> && std::is_copy_assignable_v<T>;
+
+      template <typename T>
+      concept trivially_copy_assignable_value = std::is_trivially_copy_constructible_v<T> && std::is_trivially_copy_assignable_v<T>
+         && std::is_trivially_destructible_v<T>;
+
+      template <typename T>
+      concept move_assignable_value = std::is_move_constructible_v<T> && std::is_move_assignable_v<T>;
+
+      template <typename T>
+      concept trivially_move_assignable_value = std::is_trivially_move_constructible_v<T> && std::is_trivially_move_assignable_v<T>
+         && std::is_trivially_destructible_v<T>;
+
+
+      // Whether T can be constructed from or converted from the optional type in any value category.
+      // Only class types (through their constructors) and bool (through the explicit operator bool)
+      // can be, which is checked before the eight traits.
+      template <typename T, typename opt_type>
+      concept constructible_from_optional = (std::is_class_v<T> || std::is_union_v<T> || std::is_same_v<T, bool>)
+         && (std::is_constructible_v<T, opt_type&>
+            || std::is_constructible_v<T, const opt_type&>
+            || std::is_constructible_v<T, opt_type&&>
+            || std::is_constructible_v<T, const opt_type&&>
+            || std::is_convertible_v<opt_type&, T>
+            || std::is_convertible_v<const opt_type&, T>
+            || std::is_convertible_v<opt_type&&, T>
+            || std::is_convertible_v<const opt_type&&, T>);
+
+      template <typename T, typename opt_type>
+      concept assignable_from_optional = (std::is_class_v<T> || std::is_union_v<T>)
+         && (std::is_assignable_v<T&, opt_type&>
+            || std::is_assignable_v<T&, const opt_type&>
+            || std::is_assignable_v<T&, opt_type&&>
+            || std::is_assignable_v<T&, const opt_type&&>);
+
+
+      // Constraints of the converting constructors (4) and (5), with the other optional's value as
+      // from_type. Copies and moves of the own type are left to the copy and move constructors.
+      template <typename self_type, typename opt_type, typename from_type>
+      concept optional_converting_constructible = std::is_same_v<self_type, opt_type> == false
+         && std::is_constructible_v<typename self_type::value_type, from_type>
+         && constructible_from_optional<typename self_type::value_type, opt_type> == false;
+
+      // Shared constraint of the converting assignments (5) and (6)
+      template <typename self_type, typename opt_type>
+      concept optional_converting_assignable = std::is_same_v<self_type, opt_type> == false
+         && constructible_from_optional<typename self_type::value_type, opt_type> == false
+         && assignable_from_optional<typename self_type::value_type, opt_type> == false;
+
+
+      // Whether value is the null_value. A NaN null_value never compares equal, so it's compared
+      // bitwise. Other NaNs are values. The column kernels test their elements with this as well.
+      template <auto null_value>
+      [[nodiscard]] constexpr auto is_null_value(const std::remove_cv_t<decltype(null_value)>& value) noexcept -> bool
+      {
+         using value_type = std::remove_cv_t<decltype(null_value)>;
+         if constexpr (std::is_floating_point_v<value_type>)
+         {
+            if constexpr (null_value != null_value)
+            {
+               using bits_type = std::conditional_t<sizeof(value_type) == 4, std::uint32_t, std::uint64_t>;
+               static_assert(sizeof(value_type) == sizeof(bits_type), "NaN as null_value requires a 32 or 64-bit floating-point type.");
+               return std::bit_cast<bits_type>(value) == std::bit_cast<bits_type>(null_value);
+            }
+         }
+         return value == null_value;
+      }
+
+      struct column_access;
+
+   } // namespace detail
+
 
    // intrusive_optional requires compile-time null-value
-   template<auto null_value_param, safety_mode_t safety_mode = safety_mode_t::unsafe>
+   template<auto null_value_param, safety_mode_t safety_mode = safety_mode_t::unsafe, typename telemetry_policy = no_telemetry,
+      typename failure_policy = throw_on_failure>
    struct intrusive_optional
    {
-      using value_type = decltype(null_value_param);
+      // remove_cv because class type template parameters are const objects
+      using value_type = std::remove_cv_t<decltype(null_value_param)>;
 
       constexpr inline static value_type null_value{ null_value_param };
    private:
       value_type m_value;
 
+      // Whether values are checked for unintentional nulls, and operator* and operator-> for null
+      // optionals
+      static constexpr bool null_checks = safety_mode == safety_mode_t::safe
+         || (safety_mode == safety_mode_t::debug && IO_DEBUG_CHECKS);
+      static constexpr bool access_checks = safety_mode == safety_mode_t::debug && IO_DEBUG_CHECKS;
+
+      // Whether the checks can't throw
+      static constexpr bool nothrow_checks = null_checks == false
+         || noexcept(failure_policy::fail(optional_errc::unintentionally_null));
+      static constexpr bool nothrow_access = access_checks == false
+         || noexcept(failure_policy::fail(optional_errc::bad_access));
+
    public:
 
       // Constructors: (1)
@@ -42,10 +304,11 @@ namespace io
 
       // Constructors: (2)
       constexpr intrusive_optional(const intrusive_optional&)
-         requires (std::is_copy_constructible_v<value_type> && std::is_trivially_copy_constructible_v<value_type>) = default;
+         requires detail::trivially_copy_constructible_value<value_type> = default;
 
       constexpr intrusive_optional(const intrusive_optional& other)
-         requires (std::is_copy_constructible_v<value_type> && std::is_trivially_copy_constructible_v<value_type> == false)
+         noexcept(std::is_nothrow_copy_constructible_v<value_type>)
+         requires detail::nontrivially_copy_constructible_value<value_type>
       {
           this->construct_from_optional(other);
       }
@@ -57,7 +320,7 @@ namespace io
 
       constexpr intrusive_optional(intrusive_optional&& other)
          noexcept(std::is_nothrow_move_constructible_v<value_type>)
-         requires (std::is_move_constructible_v<value_type> && std::is_trivially_move_constructible_v<value_type> == false)
+         requires detail::nontrivially_move_constructible_value<value_type>
       {
          this->construct_from_optional(std::forward<intrusive_optional>(other));
       }
@@ -65,20 +328,12 @@ namespace io
 
       // Requirement for constructors (4) and (5)
       template <auto T0, typename T = decltype(T0)>
-      static inline constexpr bool requirement_4_and_5 =
-            std::is_constructible_v<value_type, const T&>
-         && std::is_constructible_v<value_type,       intrusive_optional<T0>&>  == false
-         && std::is_constructible_v<value_type, const intrusive_optional<T0>&>  == false
-         && std::is_constructible_v<value_type,       intrusive_optional<T0>&&> == false
-         && std::is_constructible_v<value_type, const intrusive_optional<T0>&&> == false
-         && std::is_convertible_v<      intrusive_optional<T0>&,  value_type>   == false
-         && std::is_convertible_v<const intrusive_optional<T0>&,  value_type>   == false
-         && std::is_convertible_v<      intrusive_optional<T0>&&, value_type>   == false
-         && std::is_convertible_v<const intrusive_optional<T0>&&, value_type>   == false;
+      static inline constexpr bool requirement_4_and_5 = std::is_constructible_v<value_type, const T&>
+         && detail::constructible_from_optional<value_type, intrusive_optional<T0>> == false;
 
       // Constructors: (4)
       template <auto T0, typename T = decltype(T0)>
-      requires requirement_4_and_5<T0>
+      requires detail::optional_converting_constructible<intrusive_optional, intrusive_optional<T0>, const T&>
       constexpr explicit(std::is_convertible_v<const T&, value_type> == false) intrusive_optional(const intrusive_optional<T0>& other)
       {
          this->construct_from_optional(other);
@@ -87,7 +342,7 @@ namespace io
 
       // Constructors: (5)
       template <auto T0, typename T = decltype(T0)>
-      requires requirement_4_and_5<T0>
+      requires detail::optional_converting_constructible<intrusive_optional, intrusive_optional<T0>, const T&>
       constexpr explicit(std::is_convertible_v<T, value_type> == false) intrusive_optional(intrusive_optional<T0>&& other)
       {
          this->construct_from_optional(std::forward<intrusive_optional<T0>>(other));
@@ -116,6 +371,7 @@ namespace io
       // Constructor (8)
       template <typename U = value_type>
       constexpr explicit(not std::is_convertible_v<U, value_type>) intrusive_optional(U&& u)
+         noexcept(std::is_nothrow_constructible_v<value_type, U> && nothrow_checks)
          requires (std::is_constructible_v<value_type, U>
             && std::is_same_v<std::remove_cvref_t<U>, std::in_place_t> == false
             && std::is_same_v<std::remove_cvref_t<U>, intrusive_optional> == false)
@@ -127,27 +383,26 @@ namespace io
 
 
 
-      // Destructors
-      constexpr ~intrusive_optional() requires std::is_trivially_destructible_v<value_type> = default;
-
-      constexpr ~intrusive_optional() requires (std::is_trivially_destructible_v<value_type> == false)
-      {
-
-      }
+      // Destructor. The value is a plain member and destroyed implicitly, so the defaulted destructor
+      // is trivial exactly when the value_type's is.
+      constexpr ~intrusive_optional() = default;
 
 
       // operator= conditions
-      static constexpr inline bool assignment_2_cond = std::is_copy_constructible_v<value_type> && std::is_copy_assignable_v<value_type>;
-      static constexpr inline bool assignment_2_trivial_cond = std::is_trivially_copy_constructible_v<value_type> && std::is_trivially_copy_assignable_v<value_type> && std::is_trivially_destructible_v<value_type>;
-      static constexpr inline bool assignment_3_cond = std::is_move_constructible_v<value_type> && std::is_move_assignable_v<value_type>;
-      static constexpr inline bool assignment_3_trivial_cond = std::is_trivially_move_constructible_v<value_type> && std::is_trivially_move_assignable_v<value_type> && std::is_trivially_destructible_v<value_type>;
+      static constexpr inline bool assignment_2_cond = detail::copy_assignable_value<value_type>;
+      static constexpr inline bool assignment_2_trivial_cond = detail::trivially_copy_assignable_value<value_type>;
+      static constexpr inline bool assignment_3_cond = detail::move_assignable_value<value_type>;
+      static constexpr inline bool assignment_3_trivial_cond = detail::trivially_move_assignable_value<value_type>;
 
       // operator= (2)
       constexpr auto operator=(const intrusive_optional&) -> intrusive_optional&
-          = default;
+         requires detail::trivially_copy_assignable_value<value_type>
+         = default;
 
-      constexpr auto operator=(const intrusive_optional& other) -> intrusive_optional&
-         requires assignment_2_cond
+      constexpr auto operator=(const intrusive_optional& other)
+         noexcept(std::is_nothrow_copy_assignable_v<value_type> && std::is_nothrow_copy_constructible_v<value_type>)
+         -> intrusive_optional&
+         requires (detail::copy_assignable_value<value_type> && detail::trivially_copy_assignable_value<value_type> == false)
       {
          this->assign_from_optional(other);
          return *this;
@@ -158,13 +413,13 @@ namespace io
       constexpr auto operator=(intrusive_optional&&)
          noexcept(std::is_nothrow_move_assignable_v<value_type>&& std::is_nothrow_move_constructible_v<value_type>)
          -> intrusive_optional&
-         requires (assignment_3_cond && assignment_3_trivial_cond)
+         requires (detail::move_assignable_value<value_type> && detail::trivially_move_assignable_value<value_type>)
          = default;
 
       constexpr auto operator=(intrusive_optional&& other)
-      noexcept(std::is_nothrow_move_assignable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>)
-      -> intrusive_optional&
-         requires assignment_3_cond
+         noexcept(std::is_nothrow_move_assignable_v<value_type> && std::is_nothrow_move_constructible_v<value_type>)
+         -> intrusive_optional&
+         requires (detail::move_assignable_value<value_type> && detail::trivially_move_assignable_value<value_type> == false)
       {
          this->assign_from_optional(std::forward<intrusive_optional>(other));
          return *this;
@@ -180,7 +435,7 @@ namespace io
             && std::is_assignable_v<value_type&, U>)
          constexpr auto operator=(U&& u) -> intrusive_optional&
       {
-         if (this->has_value())
+         if (this->holds_value())
          {
             this->m_value = std::forward<U>(u);
          }
@@ -194,23 +449,13 @@ namespace io
 
       template<auto T0>
       static constexpr inline bool common_56_condition =
-            std::is_constructible_v<value_type,       intrusive_optional<T0>& > == false
-         && std::is_constructible_v<value_type, const intrusive_optional<T0>& > == false
-         && std::is_constructible_v<value_type,       intrusive_optional<T0>&&> == false
-         && std::is_constructible_v<value_type, const intrusive_optional<T0>&&> == false
-         && std::is_convertible_v<      intrusive_optional<T0>&,  value_type>   == false
-         && std::is_convertible_v<const intrusive_optional<T0>&,  value_type>   == false
-         && std::is_convertible_v<      intrusive_optional<T0>&&, value_type>   == false
-         && std::is_convertible_v<const intrusive_optional<T0>&&, value_type>   == false
-         && std::is_assignable_v<value_type&,       intrusive_optional<T0>&>    == false
-         && std::is_assignable_v<value_type&, const intrusive_optional<T0>&>    == false
-         && std::is_assignable_v<value_type&,       intrusive_optional<T0>&&>   == false
-         && std::is_assignable_v<value_type&, const intrusive_optional<T0>&&>   == false;
+            detail::constructible_from_optional<value_type, intrusive_optional<T0>> == false
+         && detail::assignable_from_optional<value_type, intrusive_optional<T0>> == false;
 
       // operator= (5)
       template <auto T0>
       constexpr auto operator=(const intrusive_optional<T0>& other) -> intrusive_optional&
-         requires (common_56_condition<T0>
+         requires (detail::optional_converting_assignable<intrusive_optional, intrusive_optional<T0>>
             && std::is_constructible_v<value_type, const decltype(T0)&>
             && std::is_assignable_v<value_type&, const decltype(T0)&>)
       {
@@ -221,7 +466,7 @@ namespace io
       // operator= (6)
       template <auto T0>
       constexpr auto operator=(intrusive_optional<T0>&& other) -> intrusive_optional&
-         requires (common_56_condition<T0>
+         requires (detail::optional_converting_assignable<intrusive_optional, intrusive_optional<T0>>
             && std::is_constructible_v<value_type, decltype(T0)>
             && std::is_assignable_v<value_type&, decltype(T0)>)
       {
@@ -244,8 +489,11 @@ namespace io
 
       }
 
-      // Assignment from std::optional
-      constexpr auto operator=(const std::optional<value_type>& std) -> intrusive_optional&
+      // Assignment from std::optional. This is a template so that values don't implicitly convert
+      // to std::optional and make plain assignments like opt = 5 ambiguous.
+      template <typename std_optional>
+      requires std::is_same_v<std::remove_cvref_t<std_optional>, std::optional<value_type>>
+      constexpr auto operator=(std_optional&& std) -> intrusive_optional&
       {
          if(std.has_value() == false)
          {
@@ -253,20 +501,7 @@ namespace io
          }
          else
          {
-            this->m_value = *std;
-         }
-         return *this;
-      }
-
-      constexpr auto operator=(std::optional<value_type>&& std) -> intrusive_optional&
-      {
-         if (std.has_value() == false)
-         {
-            this->reset();
-         }
-         else
-         {
-            this->m_value = std::move(*std);
+            this->m_value = *std::forward<std_optional>(std);
          }
          return *this;
       }
@@ -274,7 +509,7 @@ namespace io
 
       [[nodiscard]] constexpr auto get_std() const -> std::optional<value_type>
       {
-         if(this->has_value() == false)
+         if(this->holds_value() == false)
          {
             return std::nullopt;
          }
@@ -284,38 +519,44 @@ namespace io
 
 
       // Observers: operator->
-      constexpr auto operator->() -> value_type*
+      constexpr auto operator->() noexcept(nothrow_access) -> value_type*
       {
+         this->ensure_accessible();
          return ::std::addressof(this->m_value);
       }
 
-      constexpr auto operator->() const -> const value_type*
+      constexpr auto operator->() const noexcept(nothrow_access) -> const value_type*
       {
+         this->ensure_accessible();
          return ::std::addressof(this->m_value);
       }
 
 
 
       // Observers: operator*
-      constexpr auto operator*() const& -> const value_type&
+      constexpr auto operator*() const& noexcept(nothrow_access) -> const value_type&
       {
+         this->ensure_accessible();
          return this->m_value;
       }
 
-      constexpr auto operator*() & -> value_type&
-         requires(safety_mode == safety_mode_t::unsafe)
+      constexpr auto operator*() & noexcept(nothrow_access) -> value_type&
+         requires(safety_mode != safety_mode_t::safe)
       {
+         this->ensure_accessible();
          return this->m_value;
       }
 
-      constexpr auto operator*() && -> value_type&&
-         requires(safety_mode == safety_mode_t::unsafe)
+      constexpr auto operator*() && noexcept(nothrow_access) -> value_type&&
+         requires(safety_mode != safety_mode_t::safe)
       {
+         this->ensure_accessible();
          return ::std::move(this->m_value);
       }
 
-      constexpr auto operator*() const&& -> const value_type&&
+      constexpr auto operator*() const&& noexcept(nothrow_access) -> const value_type&&
       {
+         this->ensure_accessible();
          return ::std::move(this->m_value);
       }
 
@@ -332,8 +573,9 @@ namespace io
       // Observers: has_value
       constexpr auto has_value() const noexcept -> bool
       {
-         const bool is_equal_to_null = this->m_value == null_value;
-         return is_equal_to_null == false;
+         const bool result = this->holds_value();
+         this->record(result ? telemetry_event::value_observed : telemetry_event::null_observed);
+         return result;
       }
 
 
@@ -341,50 +583,82 @@ namespace io
       // Observers: value
       constexpr auto value() const & -> const value_type&
       {
-         if (this->has_value() == false)
+         if (this->holds_value() == false)
          {
-            throw std::bad_optional_access{};
+            this->record(telemetry_event::bad_access);
+            failure_policy::fail(optional_errc::bad_access);
          }
          return this->m_value;
       }
 
       constexpr auto value() & -> value_type&
-         requires(safety_mode == safety_mode_t::unsafe)
+         requires(safety_mode != safety_mode_t::safe)
       {
-         if (this->has_value() == false)
+         if (this->holds_value() == false)
          {
-            throw std::bad_optional_access{};
+            this->record(telemetry_event::bad_access);
+            failure_policy::fail(optional_errc::bad_access);
          }
          return this->m_value;
       }
 
       constexpr auto value() && -> value_type&&
-         requires(safety_mode == safety_mode_t::unsafe)
+         requires(safety_mode != safety_mode_t::safe)
       {
-         if (this->has_value() == false)
+         if (this->holds_value() == false)
          {
-            throw std::bad_optional_access{};
+            this->record(telemetry_event::bad_access);
+            failure_policy::fail(optional_errc::bad_access);
          }
          return ::std::move(this->m_value);
       }
 
       constexpr auto value() const && -> const value_type&&
       {
-         if (this->has_value() == false)
+         if (this->holds_value() == false)
          {
-            throw std::bad_optional_access{};
+            this->record(telemetry_event::bad_access);
+            failure_policy::fail(optional_errc::bad_access);
          }
          return ::std::move(this->m_value);
       }
 
 
 
+      // Observers: try_value. Like value(), but a null optional returns optional_errc::bad_access
+      // instead of failing.
+      [[nodiscard]] constexpr auto try_value() const& noexcept -> value_result<const value_type>
+      {
+         if (this->holds_value() == false)
+         {
+            this->record(telemetry_event::bad_access);
+            return optional_errc::bad_access;
+         }
+         return this->m_value;
+      }
+
+      [[nodiscard]] constexpr auto try_value() & noexcept -> value_result<value_type>
+         requires(safety_mode != safety_mode_t::safe)
+      {
+         if (this->holds_value() == false)
+         {
+            this->record(telemetry_event::bad_access);
+            return optional_errc::bad_access;
+         }
+         return this->m_value;
+      }
+
+      // The result would refer into the temporary
+      auto try_value() const&& = delete;
+
+
+
       // Observers: value_or
       template <typename T>
       requires (std::is_copy_constructible_v<value_type> && std::is_convertible_v<T&&, value_type>)
          constexpr auto value_or(T&& default_value) const& -> value_type
       {
-         if (this->has_value())
+         if (this->holds_value())
          {
             return this->m_value;
          }
@@ -396,7 +670,7 @@ namespace io
       requires (std::is_move_constructible_v<value_type> && std::is_convertible_v<T&&, value_type>)
          constexpr auto value_or(T&& default_value) && -> value_type
       {
-         if (this->has_value())
+         if (this->holds_value())
          {
             return ::std::move(this->m_value);
          }
@@ -406,33 +680,168 @@ namespace io
 
 
 
+      // Monadic operations: and_then
+      template <typename F>
+      constexpr auto and_then(F&& f) & requires(safety_mode != safety_mode_t::safe)
+      {
+         return and_then_impl(*this, std::forward<F>(f));
+      }
+
+      template <typename F>
+      constexpr auto and_then(F&& f) const&
+      {
+         return and_then_impl(*this, std::forward<F>(f));
+      }
+
+      template <typename F>
+      constexpr auto and_then(F&& f) && requires(safety_mode != safety_mode_t::safe)
+      {
+         return and_then_impl(std::move(*this), std::forward<F>(f));
+      }
+
+      template <typename F>
+      constexpr auto and_then(F&& f) const&&
+      {
+         return and_then_impl(std::move(*this), std::forward<F>(f));
+      }
+
+
+
+   private:
+      // Sentinel of transform() results without explicit null value
+      template <typename U>
+      static constexpr U deduced_null_value = []() -> U
+      {
+         if constexpr (std::is_same_v<U, value_type>)
+            return null_value;
+         else
+            return default_null_value<U>::value;
+      }();
+
+
+   public:
+      // Monadic operations: transform. The result is an intrusive_optional with the given
+      // result_null_value. Without one, it's this type's null_value if f returns a value_type and
+      // io::default_null_value otherwise. Results equal to the sentinel are null (or throw in
+      // safe mode). The result is constructed in place from the return value of f.
+      template <auto result_null_value, typename F>
+      constexpr auto transform(F&& f) const& -> intrusive_optional<result_null_value, safety_mode, telemetry_policy, failure_policy>
+      {
+         return transform_impl<intrusive_optional<result_null_value, safety_mode, telemetry_policy, failure_policy>>(*this, std::forward<F>(f));
+      }
+
+      template <auto result_null_value, typename F>
+      constexpr auto transform(F&& f) && -> intrusive_optional<result_null_value, safety_mode, telemetry_policy, failure_policy>
+         requires(safety_mode != safety_mode_t::safe)
+      {
+         return transform_impl<intrusive_optional<result_null_value, safety_mode, telemetry_policy, failure_policy>>(std::move(*this), std::forward<F>(f));
+      }
+
+      template <typename F, typename U = std::remove_cv_t<std::invoke_result_t<F, const value_type&>>>
+      requires (std::is_same_v<U, value_type> || has_default_null_value<U>)
+      constexpr auto transform(F&& f) const& -> intrusive_optional<deduced_null_value<U>, safety_mode, telemetry_policy, failure_policy>
+      {
+         return transform_impl<intrusive_optional<deduced_null_value<U>, safety_mode, telemetry_policy, failure_policy>>(*this, std::forward<F>(f));
+      }
+
+      template <typename F, typename U = std::remove_cv_t<std::invoke_result_t<F, value_type&&>>>
+      requires ((std::is_same_v<U, value_type> || has_default_null_value<U>) && safety_mode != safety_mode_t::safe)
+      constexpr auto transform(F&& f) && -> intrusive_optional<deduced_null_value<U>, safety_mode, telemetry_policy, failure_policy>
+      {
+         return transform_impl<intrusive_optional<deduced_null_value<U>, safety_mode, telemetry_policy, failure_policy>>(std::move(*this), std::forward<F>(f));
+      }
+
+
+
+      // Monadic operations: or_else
+      template <typename F>
+      requires (std::is_copy_constructible_v<value_type> && std::is_convertible_v<std::invoke_result_t<F>, intrusive_optional>)
+      constexpr auto or_else(F&& f) const& -> intrusive_optional
+      {
+         if (this->holds_value())
+         {
+            return *this;
+         }
+         return std::invoke(std::forward<F>(f));
+      }
+
+      template <typename F>
+      requires (std::is_move_constructible_v<value_type> && std::is_convertible_v<std::invoke_result_t<F>, intrusive_optional>)
+      constexpr auto or_else(F&& f) && -> intrusive_optional
+      {
+         if (this->holds_value())
+         {
+            return std::move(*this);
+         }
+         return std::invoke(std::forward<F>(f));
+      }
+
+
+
+      // Observers: value_or_else. Like value_or, but the default is only created when needed.
+      template <typename F>
+      requires (std::is_copy_constructible_v<value_type> && std::is_convertible_v<std::invoke_result_t<F>, value_type>)
+      constexpr auto value_or_else(F&& f) const& -> value_type
+      {
+         if (this->holds_value())
+         {
+            return this->m_value;
+         }
+         return std::invoke(std::forward<F>(f));
+      }
+
+      template <typename F>
+      requires (std::is_move_constructible_v<value_type> && std::is_convertible_v<std::invoke_result_t<F>, value_type>)
+      constexpr auto value_or_else(F&& f) && -> value_type
+      {
+         if (this->holds_value())
+         {
+            return ::std::move(this->m_value);
+         }
+         return std::invoke(std::forward<F>(f));
+      }
+
+
+
       // Modifiers: swap
       constexpr auto swap(intrusive_optional& other)
       noexcept(std::is_nothrow_move_constructible_v<value_type> && std::is_nothrow_swappable_v<value_type>) -> void
          requires std::is_move_constructible_v<value_type>
       {
-         if (this->has_value() == false && other.has_value() == false)
+         // For trivially copyable types, the null state is just another value and swapping is a
+         // plain exchange without any branches
+         if constexpr (std::is_trivially_copyable_v<value_type>)
          {
+            const value_type temp = this->m_value;
+            this->m_value = other.m_value;
+            other.m_value = temp;
             return;
          }
-         if (this->has_value() && other.has_value())
+
+         if (this->holds_value() == false && other.holds_value() == false)
+         {
+            return;
+         }
+         if (this->holds_value() && other.holds_value())
          {
             ::std::swap(this->m_value, other.m_value);
             return;
          }
-         intrusive_optional& source = this->has_value() ? *this : other;
-         intrusive_optional& target = this->has_value() ? other : *this;
+         intrusive_optional& source = this->holds_value() ? *this : other;
+         intrusive_optional& target = this->holds_value() ? other : *this;
          std::construct_at(std::addressof(target), *source);
-         source.reset();
+         source.clear();
       }
 
 
       // Modifiers: emplace (1)
       template <typename ... Args>
       requires std::is_constructible_v<value_type, Args...>
-         constexpr auto emplace(Args&&... args) -> void
+         constexpr auto emplace(Args&&... args)
+         noexcept(std::is_nothrow_constructible_v<value_type, Args...> && std::is_nothrow_copy_assignable_v<value_type> && nothrow_checks)
+         -> void
       {
-         this->reset();
+         this->clear();
          this->construct_at(std::forward<Args>(args)...);
          this->ensure_not_zero();
       }
@@ -443,22 +852,71 @@ namespace io
       requires std::is_constructible_v<value_type, std::initializer_list<U>&, Args...>
          constexpr auto emplace(std::initializer_list<U> ilist, Args&&... args) -> void
       {
-         this->reset();
+         this->clear();
          this->construct_at(ilist, std::forward<Args>(args)...);
          this->ensure_not_zero();
       }
 
 
 
-      // Modifiers: reset
-      constexpr auto reset() noexcept -> void
+      // Modifiers: modify. Calls f with a mutable reference to the value and checks once afterwards
+      // that it didn't become the null_value. This is the mutable access of safe mode, without the
+      // copy of a copy-modify-assign. Returns what f returns. A null optional fails with
+      // optional_errc::bad_access in every safety mode, before f is called.
+      template <typename F>
+      requires std::is_invocable_v<F, value_type&>
+      constexpr auto modify(F&& f) -> std::invoke_result_t<F, value_type&>
       {
-         if (this->has_value() == false)
+         this->ensure_engaged();
+         return this->modify_impl(std::forward<F>(f), this->m_value);
+      }
+
+      // Calls f with a mutable reference to a member of the value. The check is skipped for members
+      // declared with io::sentinel_independent_member.
+      template <auto member, typename F>
+      requires (std::is_member_object_pointer_v<decltype(member)>
+         && std::is_invocable_v<F, decltype((std::declval<value_type&>().*member))>)
+      constexpr auto modify(F&& f) -> std::invoke_result_t<F, decltype((std::declval<value_type&>().*member))>
+      {
+         this->ensure_engaged();
+         if constexpr (sentinel_independent_member_v<member>)
          {
-            return;
+            return std::invoke(std::forward<F>(f), this->m_value.*member);
+         }
+         else
+         {
+            return this->modify_impl(std::forward<F>(f), this->m_value.*member);
          }
+      }
 
-         this->m_value = null_value;
+
+
+      // Modifiers: try_emplace. Like emplace(), but a value equal to the null_value returns
+      // optional_errc::unintentionally_null in every safety mode instead of failing. The optional is
+      // null then.
+      template <typename ... Args>
+      requires std::is_constructible_v<value_type, Args...>
+      [[nodiscard]] constexpr auto try_emplace(Args&&... args)
+         noexcept(std::is_nothrow_constructible_v<value_type, Args...> && std::is_nothrow_copy_assignable_v<value_type>)
+         -> optional_errc
+      {
+         this->clear();
+         this->construct_at(std::forward<Args>(args)...);
+         if (this->holds_value() == false)
+         {
+            this->record(telemetry_event::sentinel_collision);
+            return optional_errc::unintentionally_null;
+         }
+         return optional_errc::none;
+      }
+
+
+
+      // Modifiers: reset
+      constexpr auto reset() noexcept(std::is_nothrow_copy_assignable_v<value_type>) -> void
+      {
+         this->record(telemetry_event::reset);
+         this->clear();
       }
 
 
@@ -466,10 +924,68 @@ namespace io
 
       // Helpers
    private:
+      template <auto, safety_mode_t, typename, typename>
+      friend struct intrusive_optional;
+
+      friend struct detail::column_access;
+
+      // Constructs the value directly from the result of the invocation, so that a prvalue result
+      // is never copied or moved
+      struct from_invoke_t {};
+
+      template <typename F, typename Arg>
+      constexpr intrusive_optional(from_invoke_t, F&& f, Arg&& arg)
+         : m_value(std::invoke(std::forward<F>(f), std::forward<Arg>(arg)))
+      {
+         this->ensure_not_zero();
+      }
+
+
+      template <typename self_type, typename F>
+      static constexpr auto and_then_impl(self_type&& self, F&& f)
+      {
+         using result_type = std::remove_cvref_t<std::invoke_result_t<F, decltype((std::forward<self_type>(self).m_value))>>;
+         static_assert(std::is_constructible_v<result_type, std::nullopt_t>, "and_then() requires a function that returns an optional.");
+         if (self.holds_value() == false)
+         {
+            return result_type(std::nullopt);
+         }
+         return std::invoke(std::forward<F>(f), std::forward<self_type>(self).m_value);
+      }
+
+
+      template <typename result_type, typename self_type, typename F>
+      static constexpr auto transform_impl(self_type&& self, F&& f) -> result_type
+      {
+         if (self.holds_value() == false)
+         {
+            return result_type{};
+         }
+         return result_type(typename result_type::from_invoke_t{}, std::forward<F>(f), std::forward<self_type>(self).m_value);
+      }
+
+
+      template <typename F, typename T>
+      constexpr auto modify_impl(F&& f, T& target) -> std::invoke_result_t<F, T&>
+      {
+         if constexpr (std::is_void_v<std::invoke_result_t<F, T&>>)
+         {
+            std::invoke(std::forward<F>(f), target);
+            this->ensure_not_zero();
+         }
+         else
+         {
+            decltype(auto) result = std::invoke(std::forward<F>(f), target);
+            this->ensure_not_zero();
+            return std::forward<decltype(result)>(result);
+         }
+      }
+
+
       template <typename opt_type>
       constexpr auto construct_from_optional(opt_type&& opt) -> void
       {
-         this->construct_at(*std::forward<opt_type>(opt));
+         this->construct_at(std::forward<opt_type>(opt).m_value);
       }
 
 
@@ -484,31 +1000,67 @@ namespace io
       constexpr auto assign_from_optional(Opt&& other) -> void
       {
          // "If both *this and other do not contain a value, the function has no effect."
-         if (this->has_value() == false && other.has_value() == false)
+         if (this->holds_value() == false && other.holds_value() == false)
          {
             return;
          }
 
          // "If *this contains a value, but other does not, then the contained value is destroyed
          // by calling its destructor. *this does not contain a value after the call."
-         if (this->has_value() && other.has_value() == false)
+         if (this->holds_value() && other.holds_value() == false)
          {
-            this->reset();
+            this->clear();
             return;
          }
 
          // "If other contains a value, then depending on whether *this contains a value, the
          // contained value is either direct-initialized or assigned from *other (2) or
          // std::move(*other) (3). Note that a moved-from optional still contains a value."
-         if (other.has_value())
+         if (other.holds_value())
          {
-            if (this->has_value())
+            if (this->holds_value())
             {
-               **this = *std::forward<Opt>(other);
+               this->m_value = std::forward<Opt>(other).m_value;
             }
             else
             {
-               this->construct_at(*std::forward<Opt>(other));
+               this->construct_at(std::forward<Opt>(other).m_value);
+            }
+         }
+      }
+
+
+      // has_value() without telemetry, for the members
+      constexpr auto holds_value() const noexcept -> bool
+      {
+         return detail::is_null_value<null_value_param>(this->m_value) == false;
+      }
+
+
+      // reset() without telemetry, for the members
+      constexpr auto clear() noexcept(std::is_nothrow_copy_assignable_v<value_type>) -> void
+      {
+         // Overwriting a null with null is unobservable for trivial types. Skipping the check
+         // avoids a branch, compilers can't turn a conditional store into an unconditional one.
+         if constexpr (std::is_trivially_copy_assignable_v<value_type> == false)
+         {
+            if (this->holds_value() == false)
+            {
+               return;
+            }
+         }
+
+         this->m_value = null_value;
+      }
+
+
+      constexpr auto record(const telemetry_event event) const noexcept -> void
+      {
+         if constexpr (telemetry_policy::enabled)
+         {
+            if (std::is_constant_evaluated() == false)
+            {
+               telemetry_policy::template record<intrusive_optional>(event);
             }
          }
       }
@@ -516,11 +1068,39 @@ namespace io
 
       constexpr auto ensure_not_zero() const -> void
       {
-         if constexpr (safety_mode == safety_mode_t::safe)
+         if constexpr (null_checks || telemetry_policy::enabled)
+         {
+            if (this->holds_value() == false)
+            {
+               this->record(telemetry_event::sentinel_collision);
+               if constexpr (null_checks)
+               {
+                  failure_policy::fail(optional_errc::unintentionally_null);
+               }
+            }
+         }
+      }
+
+
+      // Unlike ensure_accessible(), in every safety mode
+      constexpr auto ensure_engaged() const -> void
+      {
+         if (this->holds_value() == false)
          {
-            if (this->has_value() == false)
+            this->record(telemetry_event::bad_access);
+            failure_policy::fail(optional_errc::bad_access);
+         }
+      }
+
+
+      constexpr auto ensure_accessible() const noexcept(nothrow_access) -> void
+      {
+         if constexpr (access_checks)
+         {
+            if (this->holds_value() == false)
             {
-               throw unintentionally_null{};
+               this->record(telemetry_event::bad_access);
+               failure_policy::fail(optional_errc::bad_access);
             }
          }
       }
@@ -529,9 +1109,26 @@ namespace io
    }; // intrusive_optional
 
 
+   namespace detail
+   {
+
+      // The stored value for the column kernels, which read and write null elements directly. Skips
+      // the checks of every safety mode and the telemetry, like the kernels skip per-element calls.
+      struct column_access
+      {
+         template <typename opt_type>
+         [[nodiscard]] static constexpr auto value(opt_type& opt) noexcept -> auto&
+         {
+            return opt.m_value;
+         }
+      };
+
+   } // namespace detail
+
+
    // Non-member functions; comparisons (1-6)
-   template <auto T0, auto T1>
-   constexpr auto operator==(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1>
+   constexpr auto operator==(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs) -> bool
       requires requires { bool(*lhs == *rhs); }
    {
       if (bool(lhs) != bool(rhs))
@@ -542,8 +1139,8 @@ namespace io
    }
 
    // comparison (2)
-   template <auto T0, auto T1>
-   constexpr auto operator!=(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1>
+   constexpr auto operator!=(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs) -> bool
       requires requires { bool(*lhs != *rhs); }
    {
       if (bool(lhs) != bool(rhs))
@@ -554,8 +1151,8 @@ namespace io
    }
 
    // comparison (3)
-   template <auto T0, auto T1>
-   constexpr auto operator<(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1>
+   constexpr auto operator<(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs) -> bool
       requires requires { bool(*lhs < *rhs); }
    {
       if (bool(rhs) == false)
@@ -566,8 +1163,8 @@ namespace io
    }
 
    // comparison (4)
-   template <auto T0, auto T1>
-   constexpr auto operator<=(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1>
+   constexpr auto operator<=(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs) -> bool
       requires requires { bool(*lhs <= *rhs); }
    {
       if (bool(lhs) == false)
@@ -579,8 +1176,8 @@ namespace io
    
 
    // comparison (5)
-   template <auto T0, auto T1>
-   constexpr auto operator>(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1>
+   constexpr auto operator>(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs) -> bool
       requires requires { bool(*lhs > * rhs); }
    {
       if (bool(lhs) == false)
@@ -591,8 +1188,8 @@ namespace io
    }
 
    // comparison (6)
-   template <auto T0, auto T1>
-   constexpr auto operator>=(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1>
+   constexpr auto operator>=(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs) -> bool
       requires requires { bool(*lhs >= *rhs); }
    {
       if (bool(lhs) == false)
@@ -603,8 +1200,8 @@ namespace io
    }
 
    // comparison (7)
-   template<auto T0, auto T1> requires std::three_way_comparable_with<decltype(T0), decltype(T1)>
-   constexpr auto operator<=>(const intrusive_optional<T0>& lhs, const intrusive_optional<T1>& rhs)
+   template <auto T0, safety_mode_t mode0, typename ... policies0, auto T1, safety_mode_t mode1, typename ... policies1> requires std::three_way_comparable_with<decltype(T0), decltype(T1)>
+   constexpr auto operator<=>(const intrusive_optional<T0, mode0, policies0...>& lhs, const intrusive_optional<T1, mode1, policies1...>& rhs)
       -> std::compare_three_way_result_t<decltype(T0), decltype(T1)>
    {
       if (lhs && rhs)
@@ -616,99 +1213,99 @@ namespace io
    }
 
    // comparison (8)
-   template<auto T0>
-   constexpr auto operator==(const intrusive_optional<T0>& opt, std::nullopt_t) noexcept -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator==(const intrusive_optional<T0, mode0, policies0...>& opt, std::nullopt_t) noexcept -> bool
    {
       return opt.has_value() == false;
    }
 
    // comparison (20)
-   template <auto T0>
-   constexpr auto operator<=>(const intrusive_optional<T0>& opt, std::nullopt_t) noexcept -> std::strong_ordering
+   template <auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator<=>(const intrusive_optional<T0, mode0, policies0...>& opt, std::nullopt_t) noexcept -> std::strong_ordering
    {
       return opt.has_value() <=> false;
    }
 
    // comparison (21)
-   template<auto T0, typename T>
-   constexpr auto operator==(const intrusive_optional<T0>& opt, const T& value) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, typename T>
+   constexpr auto operator==(const intrusive_optional<T0, mode0, policies0...>& opt, const T& value) -> bool
    {
       return bool(opt) ? *opt == value : false;
    }
 
    // comparison (22)
-   template<typename T, auto T0>
-   constexpr auto operator==(const T& value, const intrusive_optional<T0>& opt) -> bool
+   template <typename T, auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator==(const T& value, const intrusive_optional<T0, mode0, policies0...>& opt) -> bool
    {
       return bool(opt) ? value == *opt : false;
    }
 
    // comparison (23)
-   template<auto T0, typename T>
-   constexpr auto operator!=(const intrusive_optional<T0>& opt, const T& value) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, typename T>
+   constexpr auto operator!=(const intrusive_optional<T0, mode0, policies0...>& opt, const T& value) -> bool
    {
       return bool(opt) ? *opt != value : false;
    }
 
    // comparison (24)
-   template<typename T, auto T0>
-   constexpr auto operator!=(const T& value, const intrusive_optional<T0>& opt) -> bool
+   template <typename T, auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator!=(const T& value, const intrusive_optional<T0, mode0, policies0...>& opt) -> bool
    {
       return bool(opt) ? value != *opt : false;
    }
 
    // comparison (25)
-   template<auto T0, typename T>
-   constexpr auto operator<(const intrusive_optional<T0>& opt, const T& value) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, typename T>
+   constexpr auto operator<(const intrusive_optional<T0, mode0, policies0...>& opt, const T& value) -> bool
    {
       return bool(opt) ? *opt < value : false;
    }
 
    // comparison (26)
-   template<typename T, auto T0>
-   constexpr auto operator<(const T& value, const intrusive_optional<T0>& opt) -> bool
+   template <typename T, auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator<(const T& value, const intrusive_optional<T0, mode0, policies0...>& opt) -> bool
    {
       return bool(opt) ? value < *opt : false;
    }
 
    // comparison (27)
-   template<auto T0, typename T>
-   constexpr auto operator<=(const intrusive_optional<T0>& opt, const T& value) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, typename T>
+   constexpr auto operator<=(const intrusive_optional<T0, mode0, policies0...>& opt, const T& value) -> bool
    {
       return bool(opt) ? *opt <= value : false;
    }
 
    // comparison (28)
-   template<typename T, auto T0>
-   constexpr auto operator<=(const T& value, const intrusive_optional<T0>& opt) -> bool
+   template <typename T, auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator<=(const T& value, const intrusive_optional<T0, mode0, policies0...>& opt) -> bool
    {
       return bool(opt) ? value <= *opt : false;
    }
 
    // comparison (29)
-   template<auto T0, typename T>
-   constexpr auto operator>(const intrusive_optional<T0>& opt, const T& value) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, typename T>
+   constexpr auto operator>(const intrusive_optional<T0, mode0, policies0...>& opt, const T& value) -> bool
    {
       return bool(opt) ? *opt > value : false;
    }
 
    // comparison (30)
-   template<typename T, auto T0>
-   constexpr auto operator>(const T& value, const intrusive_optional<T0>& opt) -> bool
+   template <typename T, auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator>(const T& value, const intrusive_optional<T0, mode0, policies0...>& opt) -> bool
    {
       return bool(opt) ? value > *opt : false;
    }
 
    // comparison (31)
-   template<auto T0, typename T>
-   constexpr auto operator>=(const intrusive_optional<T0>& opt, const T& value) -> bool
+   template <auto T0, safety_mode_t mode0, typename ... policies0, typename T>
+   constexpr auto operator>=(const intrusive_optional<T0, mode0, policies0...>& opt, const T& value) -> bool
    {
       return bool(opt) ? *opt >= value : false;
    }
 
    // comparison (32)
-   template<typename T, auto T0>
-   constexpr auto operator>=(const T& value, const intrusive_optional<T0>& opt) -> bool
+   template <typename T, auto T0, safety_mode_t mode0, typename ... policies0>
+   constexpr auto operator>=(const T& value, const intrusive_optional<T0, mode0, policies0...>& opt) -> bool
    {
       return bool(opt) ? value >= *opt : false;
    }
@@ -716,7 +1313,7 @@ namespace io
    // comparison (33)
    // This currently conflicts with comparison (7)
    //template<auto T0, std::three_way_comparable_with<int> U >
-   //constexpr auto operator<=>(const intrusive_optional<T0>& opt, const U& value)
+   //constexpr auto operator<=>(const intrusive_optional<T0, mode0, policies0...>& opt, const U& value)
    //   -> std::compare_three_way_result_t<int, U>
    //{
    //   return bool(opt) ? *opt <=> value : std::strong_ordering::less;
@@ -740,13 +1337,30 @@ namespace io
       return intrusive_optional<T0> {std::in_place, il, std::forward<Args>(args)...};
    }
 
+   // make_optional (2) and (3) with an explicit mode and optionally policies after the null value.
+   // The mode has no default, so that make_optional<T0>(args...) only matches the overloads above.
+   template <auto T0, safety_mode_t mode0, typename telemetry_policy = no_telemetry,
+      typename failure_policy = throw_on_failure, typename ... Args>
+   constexpr auto make_optional(Args&&... args) -> intrusive_optional<T0, mode0, telemetry_policy, failure_policy>
+   {
+      return intrusive_optional<T0, mode0, telemetry_policy, failure_policy>{std::in_place, std::forward<Args>(args)...};
+   }
+
+   template <auto T0, safety_mode_t mode0, typename telemetry_policy = no_telemetry,
+      typename failure_policy = throw_on_failure, typename U, typename ... Args>
+   constexpr auto make_optional(std::initializer_list<U> il, Args&&... args)
+      -> intrusive_optional<T0, mode0, telemetry_policy, failure_policy>
+   {
+      return intrusive_optional<T0, mode0, telemetry_policy, failure_policy> {std::in_place, il, std::forward<Args>(args)...};
+   }
+
 
 
 
    // Non-member functions: std::swap
-   template <auto null_value, typename T = decltype(null_value)>
-   requires (std::is_move_constructible_v<T> && std::is_swappable_v<T>)
-      constexpr auto swap(intrusive_optional<null_value>& x, intrusive_optional<null_value>& y)
+   template <auto T0, safety_mode_t mode0, typename ... policies0>
+   requires (std::is_move_constructible_v<decltype(T0)> && std::is_swappable_v<decltype(T0)>)
+      constexpr auto swap(intrusive_optional<T0, mode0, policies0...>& x, intrusive_optional<T0, mode0, policies0...>& y)
       noexcept(noexcept(x.swap(y)))
    -> void
    {
@@ -754,22 +1368,69 @@ namespace io
    }
 
 
+
+
+   // Trivial relocation: Moving an object to new storage and destroying the old one is equivalent to
+   // a memcpy. This holds for trivially copyable types and can be declared for other types by
+   // specializing this trait. intrusive_optional is trivially relocatable if its value_type is.
+   template <typename T>
+   struct is_trivially_relocatable : std::bool_constant<std::is_trivially_copyable_v<T>> {};
+
+   template <auto T0, safety_mode_t safety_mode, typename ... policies>
+   struct is_trivially_relocatable<intrusive_optional<T0, safety_mode, policies...>>
+      : is_trivially_relocatable<typename intrusive_optional<T0, safety_mode, policies...>::value_type> {};
+
+   template <typename T>
+   constexpr inline bool is_trivially_relocatable_v = is_trivially_relocatable<T>::value;
+
+
+   // Moves [first, last) into the uninitialized storage at target and destroys the source objects.
+   // Uses memcpy for trivially relocatable types, at runtime.
+   template <typename T>
+   auto uninitialized_relocate(T* first, T* last, T* target)
+      noexcept(is_trivially_relocatable_v<T> || std::is_nothrow_move_constructible_v<T>) -> T*
+   {
+      if constexpr (is_trivially_relocatable_v<T>)
+      {
+         const std::size_t count = static_cast<std::size_t>(last - first);
+         if (count > 0)
+         {
+            std::memmove(static_cast<void*>(target), static_cast<const void*>(first), count * sizeof(T));
+         }
+         return target + count;
+      }
+      else
+      {
+         for (; first != last; ++first, ++target)
+         {
+            std::construct_at(target, std::move(*first));
+            std::destroy_at(first);
+         }
+         return target;
+      }
+   }
+
 } // namespace io
 
 
 namespace std
 {
-   template <auto T0>
-   struct hash<io::intrusive_optional<T0>>
+   // Only enabled if the value_type is hashable, like std::hash<std::optional>
+   template <auto T0, io::safety_mode_t safety_mode, typename ... policies>
+   requires requires(const typename io::intrusive_optional<T0, safety_mode, policies...>::value_type& value)
+   {
+      std::hash<typename io::intrusive_optional<T0, safety_mode, policies...>::value_type>{}(value);
+   }
+   struct hash<io::intrusive_optional<T0, safety_mode, policies...>>
    {
-      auto operator()(const io::intrusive_optional<T0>& optional) const -> std::size_t
+      auto operator()(const io::intrusive_optional<T0, safety_mode, policies...>& optional) const -> std::size_t
       {
          if (optional.has_value() == false)
          {
             // "For an optional that does not contain a value, the hash is unspecified."
             return static_cast<std::size_t>(0);
          }
-         using value_type = decltype(T0);
+         using value_type = typename io::intrusive_optional<T0, safety_mode, policies...>::value_type;
          return std::hash<value_type>{}(*optional);
       }
    };
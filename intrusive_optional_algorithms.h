@@ -0,0 +1,625 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "intrusive_optional.h"
+
+
+namespace io
+{
+
+   template <typename T>
+   struct is_intrusive_optional : std::false_type {};
+
+   template <auto T0, safety_mode_t safety_mode, typename ... policies>
+   struct is_intrusive_optional<intrusive_optional<T0, safety_mode, policies...>> : std::true_type {};
+
+   template <typename T>
+   constexpr inline bool is_intrusive_optional_v = is_intrusive_optional<std::remove_cv_t<T>>::value;
+
+
+   // A column is a contiguous range of intrusive_optionals. Since the null state is encoded in the
+   // value itself, a column is just an array of values - with no validity bitmap next to it. The
+   // kernels work on columns of every safety mode and policy. They access the elements raw, so they
+   // neither run the checks nor record telemetry per element.
+   template <typename R>
+   concept optional_column = std::ranges::contiguous_range<R>
+      && std::ranges::sized_range<R>
+      && is_intrusive_optional_v<std::ranges::range_value_t<R>>;
+
+   template <typename R>
+   concept mutable_optional_column = optional_column<R>
+      && std::is_const_v<std::remove_reference_t<std::ranges::range_reference_t<R>>> == false;
+
+   template <optional_column R>
+   using column_optional_t = std::remove_cv_t<std::ranges::range_value_t<R>>;
+
+   template <optional_column R>
+   using column_value_t = typename column_optional_t<R>::value_type;
+
+
+   namespace detail
+   {
+
+      // The stored value of a column element, null or not
+      template <typename opt_type>
+      [[nodiscard]] constexpr auto raw(opt_type& opt) noexcept -> auto&
+      {
+         return column_access::value(opt);
+      }
+
+      // Whether an element of a column is null. Kernels test elements and raw values with this
+      // instead of comparing with the null_value, which never matches a NaN sentinel.
+      template <typename opt_type>
+      [[nodiscard]] constexpr auto is_null(const opt_type& opt) noexcept -> bool
+      {
+         return is_null_value<opt_type::null_value>(raw(opt));
+      }
+
+      [[nodiscard]] constexpr auto mix_hash(std::uint64_t value) -> std::uint64_t
+      {
+         // Finalizer of MurmurHash3
+         value ^= value >> 33;
+         value *= 0xff51afd7ed558ccdull;
+         value ^= value >> 33;
+         value *= 0xc4ceb9fe1a85ec53ull;
+         value ^= value >> 33;
+         return value;
+      }
+
+   } // namespace detail
+
+
+   // Number of null elements. The loop is a plain compare-and-add without branches which compilers
+   // turn into vector compares for scalar value types.
+   template <optional_column R>
+   [[nodiscard]] constexpr auto count_null(R&& column) -> std::size_t
+   {
+      const auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+      std::size_t result = 0;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         result += static_cast<std::size_t>(detail::is_null(data[i]));
+      }
+      return result;
+   }
+
+
+   // Sets every element to null by writing the sentinel. Unlike calling reset() on each element,
+   // this doesn't check the current state first.
+   template <mutable_optional_column R>
+   constexpr auto fill_null(R&& column) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      std::ranges::fill(column, opt_type{});
+   }
+
+
+
+   // Swaps the elements of two columns up to the shorter length. For trivially copyable value types
+   // this is a plain exchange loop that compilers vectorize, engaged and null elements alike.
+   template <mutable_optional_column R1, mutable_optional_column R2>
+   requires std::is_same_v<column_optional_t<R1>, column_optional_t<R2>>
+   constexpr auto swap_ranges(R1&& first, R2&& second) -> std::size_t
+   {
+      using value_type = column_value_t<R1>;
+      auto* first_data = std::ranges::data(first);
+      auto* second_data = std::ranges::data(second);
+      const std::size_t size = std::min(std::ranges::size(first), std::ranges::size(second));
+      if constexpr (std::is_trivially_copyable_v<value_type>)
+      {
+         for (std::size_t i = 0; i < size; ++i)
+         {
+            const value_type temp = detail::raw(first_data[i]);
+            detail::raw(first_data[i]) = detail::raw(second_data[i]);
+            detail::raw(second_data[i]) = temp;
+         }
+      }
+      else
+      {
+         for (std::size_t i = 0; i < size; ++i)
+         {
+            first_data[i].swap(second_data[i]);
+         }
+      }
+      return size;
+   }
+
+
+   // Rotates the column so that the element at index middle becomes the first one. Returns the new
+   // index of the previously first element, like std::rotate. For trivially copyable value types
+   // the shorter part goes through a buffer and everything else is moved with block copies.
+   template <mutable_optional_column R>
+   auto rotate(R&& column, const std::size_t middle) -> std::size_t
+   {
+      using opt_type = column_optional_t<R>;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+      if (middle == 0 || middle >= size)
+      {
+         return middle == 0 ? size : 0;
+      }
+      if constexpr (std::is_trivially_copyable_v<opt_type>)
+      {
+         const std::size_t tail = size - middle;
+         if (middle <= tail)
+         {
+            const std::vector<opt_type> buffer(data, data + middle);
+            std::copy(data + middle, data + size, data);
+            std::copy(buffer.begin(), buffer.end(), data + tail);
+         }
+         else
+         {
+            const std::vector<opt_type> buffer(data + middle, data + size);
+            std::copy_backward(data, data + middle, data + size);
+            std::copy(buffer.begin(), buffer.end(), data);
+         }
+         return tail;
+      }
+      else
+      {
+         return static_cast<std::size_t>(std::rotate(data, data + middle, data + size) - data);
+      }
+   }
+
+
+   // Gap filling. The sequential kernels are a single pass with a select instead of a branch per
+   // element. Leading nulls (trailing for backward_fill) have nothing to fill from and stay null.
+   template <mutable_optional_column R>
+   constexpr auto forward_fill(R&& column) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+      value_type last = opt_type::null_value;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         const value_type& value = detail::raw(data[i]);
+         last = detail::is_null_value<opt_type::null_value>(value) ? last : value;
+         detail::raw(data[i]) = last;
+      }
+   }
+
+
+   // Fills at most limit consecutive nulls after each value
+   template <mutable_optional_column R>
+   constexpr auto forward_fill(R&& column, const std::size_t limit) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+      value_type last = opt_type::null_value;
+      std::size_t run = 0;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         const value_type& value = detail::raw(data[i]);
+         const bool is_null = detail::is_null_value<opt_type::null_value>(value);
+         run = is_null ? run + 1 : 0;
+         last = is_null ? last : value;
+         detail::raw(data[i]) = run <= limit ? last : opt_type::null_value;
+      }
+   }
+
+
+   template <mutable_optional_column R>
+   constexpr auto backward_fill(R&& column) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      value_type next = opt_type::null_value;
+      for (std::size_t i = std::ranges::size(column); i-- > 0; )
+      {
+         const value_type& value = detail::raw(data[i]);
+         next = detail::is_null_value<opt_type::null_value>(value) ? next : value;
+         detail::raw(data[i]) = next;
+      }
+   }
+
+
+   // Fills at most limit consecutive nulls before each value
+   template <mutable_optional_column R>
+   constexpr auto backward_fill(R&& column, const std::size_t limit) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      value_type next = opt_type::null_value;
+      std::size_t run = 0;
+      for (std::size_t i = std::ranges::size(column); i-- > 0; )
+      {
+         const value_type& value = detail::raw(data[i]);
+         const bool is_null = detail::is_null_value<opt_type::null_value>(value);
+         run = is_null ? run + 1 : 0;
+         next = is_null ? next : value;
+         detail::raw(data[i]) = run <= limit ? next : opt_type::null_value;
+      }
+   }
+
+
+   namespace detail
+   {
+
+      // Fills the count - 1 elements between first and last with linearly interpolated values.
+      // Integers are interpolated exactly and rounded to nearest: The offset from first is
+      // |last - first| * j / count, accumulated as quotient and remainder so that nothing overflows.
+      template <typename opt_type>
+      constexpr auto interpolate_gap(opt_type* data, const std::size_t count) -> void
+      {
+         using value_type = typename opt_type::value_type;
+         const value_type first = raw(data[0]);
+         const value_type last = raw(data[count]);
+         if constexpr (std::is_integral_v<value_type> && std::is_same_v<value_type, bool> == false)
+         {
+            using unsigned_type = std::make_unsigned_t<value_type>;
+            const bool ascending = first <= last;
+            const unsigned_type magnitude = ascending
+               ? static_cast<unsigned_type>(static_cast<unsigned_type>(last) - static_cast<unsigned_type>(first))
+               : static_cast<unsigned_type>(static_cast<unsigned_type>(first) - static_cast<unsigned_type>(last));
+            const unsigned_type quotient = static_cast<unsigned_type>(magnitude / count);
+            const std::size_t remainder = static_cast<std::size_t>(magnitude % count);
+            unsigned_type offset = 0;
+            std::size_t accumulator = count / 2;
+            for (std::size_t j = 1; j < count; ++j)
+            {
+               offset = static_cast<unsigned_type>(offset + quotient);
+               accumulator += remainder;
+               const bool carry = accumulator >= count;
+               accumulator -= carry ? count : 0;
+               offset = static_cast<unsigned_type>(offset + (carry ? 1 : 0));
+               const unsigned_type base = static_cast<unsigned_type>(first);
+               raw(data[j]) = static_cast<value_type>(ascending ? static_cast<unsigned_type>(base + offset) : static_cast<unsigned_type>(base - offset));
+            }
+         }
+         else
+         {
+            const double start = static_cast<double>(first);
+            const double slope = (static_cast<double>(last) - start) / static_cast<double>(count);
+            for (std::size_t j = 1; j < count; ++j)
+            {
+               raw(data[j]) = static_cast<value_type>(start + slope * static_cast<double>(j));
+            }
+         }
+
+         // A result equal to the sentinel would read as a gap. It's moved by the smallest step
+         // towards first, which can't be the sentinel as first is a value.
+         for (std::size_t j = 1; j < count; ++j)
+         {
+            value_type& value = raw(data[j]);
+            if (is_null_value<opt_type::null_value>(value))
+            {
+               if constexpr (std::is_floating_point_v<value_type>)
+               {
+                  value = std::nextafter(value, first);
+               }
+               else
+               {
+                  value = static_cast<value_type>(value < first ? value + 1 : value - 1);
+               }
+            }
+         }
+      }
+
+   } // namespace detail
+
+
+   // Linear interpolation by index between the neighbouring values of each interior gap. Gaps at
+   // the start or the end of the column stay null. Integer columns are interpolated exactly.
+   // Interpolated values never equal the sentinel: Those are moved by one step towards the value
+   // before the gap.
+   template <mutable_optional_column R>
+   requires std::is_arithmetic_v<column_value_t<R>>
+   constexpr auto interpolate_linear(R&& column) -> void
+   {
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::size_t previous = size;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         if (detail::is_null(data[i]))
+         {
+            continue;
+         }
+         if (previous != size && i - previous > 1)
+         {
+            detail::interpolate_gap(data + previous, i - previous);
+         }
+         previous = i;
+      }
+   }
+
+
+   namespace detail
+   {
+
+      // Runs fn(begin, end, chunk) for thread_count contiguous chunks of [0, size) on their own threads
+      template <typename fn_type>
+      auto for_each_chunk(const std::size_t size, std::size_t thread_count, const fn_type& fn) -> std::size_t
+      {
+         thread_count = std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(size, 1));
+         const std::size_t chunk_size = (size + thread_count - 1) / thread_count;
+         std::vector<std::jthread> threads;
+         threads.reserve(thread_count);
+         for (std::size_t chunk = 0; chunk < thread_count; ++chunk)
+         {
+            const std::size_t begin = std::min(chunk * chunk_size, size);
+            const std::size_t end = std::min(begin + chunk_size, size);
+            threads.emplace_back(fn, begin, end, chunk);
+         }
+         return thread_count;
+      }
+
+
+      // The null runs at both ends of a chunk and the values next to them, taken before the chunk
+      // is filled. The values are the null_value if the chunk is all null.
+      template <typename value_type>
+      struct chunk_edges
+      {
+         std::size_t leading_nulls = 0;
+         std::size_t trailing_nulls = 0;
+         value_type first_value;
+         value_type last_value;
+      };
+
+      template <typename opt_type>
+      [[nodiscard]] auto edges_of(const opt_type* data, const std::size_t begin, const std::size_t end) -> chunk_edges<typename opt_type::value_type>
+      {
+         chunk_edges<typename opt_type::value_type> result{ end - begin, end - begin, opt_type::null_value, opt_type::null_value };
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            if (is_null(data[i]) == false)
+            {
+               result.leading_nulls = i - begin;
+               result.first_value = raw(data[i]);
+               break;
+            }
+         }
+         for (std::size_t i = end; i-- > begin; )
+         {
+            if (is_null(data[i]) == false)
+            {
+               result.trailing_nulls = end - 1 - i;
+               result.last_value = raw(data[i]);
+               break;
+            }
+         }
+         return result;
+      }
+
+      // Carry of the limited fills: The value to fill with and the nulls between it and the chunk
+      template <typename value_type>
+      struct fill_carry
+      {
+         value_type value;
+         std::size_t run = 0;
+      };
+
+      // How many of the nulls at the edge of a chunk a carry may fill
+      [[nodiscard]] constexpr auto carry_fill_count(const std::size_t run, const std::size_t nulls, const std::size_t limit) -> std::size_t
+      {
+         return limit > run ? std::min(nulls, limit - run) : 0;
+      }
+
+   } // namespace detail
+
+
+   // Parallel forward_fill. Every chunk is filled independently first. A sequential pass over the
+   // chunks then propagates the last value of each chunk as carry, and the leading null runs of
+   // the chunks are filled with their carry in parallel.
+   template <mutable_optional_column R>
+   auto parallel_forward_fill(R&& column, const std::size_t thread_count = std::thread::hardware_concurrency()) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::vector<std::size_t> chunk_ends(std::max<std::size_t>(thread_count, 1));
+      const std::size_t chunk_count = detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         forward_fill(std::span(data + begin, data + end));
+         chunk_ends[chunk] = end;
+      });
+
+      std::vector<value_type> carries(chunk_count, opt_type::null_value);
+      for (std::size_t chunk = 1; chunk < chunk_count; ++chunk)
+      {
+         const std::size_t previous_end = chunk_ends[chunk - 1];
+         const bool previous_has_value = previous_end > 0 && detail::is_null(data[previous_end - 1]) == false;
+         carries[chunk] = previous_has_value ? detail::raw(data[previous_end - 1]) : carries[chunk - 1];
+      }
+
+      detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         for (std::size_t i = begin; i < end && detail::is_null(data[i]); ++i)
+         {
+            detail::raw(data[i]) = carries[chunk];
+         }
+      });
+   }
+
+
+   template <mutable_optional_column R>
+   auto parallel_backward_fill(R&& column, const std::size_t thread_count = std::thread::hardware_concurrency()) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::vector<std::size_t> chunk_begins(std::max<std::size_t>(thread_count, 1));
+      const std::size_t chunk_count = detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         backward_fill(std::span(data + begin, data + end));
+         chunk_begins[chunk] = begin;
+      });
+
+      std::vector<value_type> carries(chunk_count, opt_type::null_value);
+      for (std::size_t chunk = chunk_count - 1; chunk-- > 0; )
+      {
+         const std::size_t next_begin = chunk_begins[chunk + 1];
+         const bool next_has_value = next_begin < size && detail::is_null(data[next_begin]) == false;
+         carries[chunk] = next_has_value ? detail::raw(data[next_begin]) : carries[chunk + 1];
+      }
+
+      detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         for (std::size_t i = end; i-- > begin && detail::is_null(data[i]); )
+         {
+            detail::raw(data[i]) = carries[chunk];
+         }
+      });
+   }
+
+
+
+   // Parallel forward_fill(column, limit). The carry into each chunk is the last value before it and
+   // the number of nulls since, so that null runs across chunk boundaries count towards the limit
+   // as a whole. thread_count has no default here, since (column, n) is the overload without limit.
+   template <mutable_optional_column R>
+   auto parallel_forward_fill(R&& column, const std::size_t limit, const std::size_t thread_count) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::vector<detail::chunk_edges<value_type>> edges(std::max<std::size_t>(thread_count, 1));
+      const std::size_t chunk_count = detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         edges[chunk] = detail::edges_of(data, begin, end);
+         forward_fill(std::span(data + begin, data + end), limit);
+      });
+
+      std::vector<detail::fill_carry<value_type>> carries(chunk_count, { opt_type::null_value, 0 });
+      for (std::size_t chunk = 1; chunk < chunk_count; ++chunk)
+      {
+         const detail::chunk_edges<value_type>& previous = edges[chunk - 1];
+         const bool previous_has_value = detail::is_null_value<opt_type::null_value>(previous.last_value) == false;
+         carries[chunk] = previous_has_value
+            ? detail::fill_carry<value_type>{ previous.last_value, previous.trailing_nulls }
+            : detail::fill_carry<value_type>{ carries[chunk - 1].value, carries[chunk - 1].run + previous.trailing_nulls };
+      }
+
+      detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t, const std::size_t chunk)
+      {
+         const detail::fill_carry<value_type>& carry = carries[chunk];
+         if (detail::is_null_value<opt_type::null_value>(carry.value))
+         {
+            return;
+         }
+         const std::size_t count = detail::carry_fill_count(carry.run, edges[chunk].leading_nulls, limit);
+         for (std::size_t i = begin; i < begin + count; ++i)
+         {
+            detail::raw(data[i]) = carry.value;
+         }
+      });
+   }
+
+
+   // Parallel backward_fill(column, limit), the mirror image of the limited parallel_forward_fill
+   template <mutable_optional_column R>
+   auto parallel_backward_fill(R&& column, const std::size_t limit, const std::size_t thread_count) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::vector<detail::chunk_edges<value_type>> edges(std::max<std::size_t>(thread_count, 1));
+      const std::size_t chunk_count = detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         edges[chunk] = detail::edges_of(data, begin, end);
+         backward_fill(std::span(data + begin, data + end), limit);
+      });
+
+      std::vector<detail::fill_carry<value_type>> carries(chunk_count, { opt_type::null_value, 0 });
+      for (std::size_t chunk = chunk_count - 1; chunk-- > 0; )
+      {
+         const detail::chunk_edges<value_type>& next = edges[chunk + 1];
+         const bool next_has_value = detail::is_null_value<opt_type::null_value>(next.first_value) == false;
+         carries[chunk] = next_has_value
+            ? detail::fill_carry<value_type>{ next.first_value, next.leading_nulls }
+            : detail::fill_carry<value_type>{ carries[chunk + 1].value, carries[chunk + 1].run + next.leading_nulls };
+      }
+
+      detail::for_each_chunk(size, thread_count, [&](const std::size_t, const std::size_t end, const std::size_t chunk)
+      {
+         const detail::fill_carry<value_type>& carry = carries[chunk];
+         if (detail::is_null_value<opt_type::null_value>(carry.value))
+         {
+            return;
+         }
+         const std::size_t count = detail::carry_fill_count(carry.run, edges[chunk].trailing_nulls, limit);
+         for (std::size_t i = end - count; i < end; ++i)
+         {
+            detail::raw(data[i]) = carry.value;
+         }
+      });
+   }
+
+
+   // Parallel interpolate_linear. Every chunk interpolates its interior gaps first. The gaps across
+   // chunk boundaries, at most one per boundary, are interpolated in parallel afterwards. The
+   // results are the same as those of interpolate_linear.
+   template <mutable_optional_column R>
+   requires std::is_arithmetic_v<column_value_t<R>>
+   auto parallel_interpolate_linear(R&& column, const std::size_t thread_count = std::thread::hardware_concurrency()) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::vector<detail::chunk_edges<value_type>> edges(std::max<std::size_t>(thread_count, 1));
+      std::vector<std::size_t> chunk_begins(edges.size());
+      const std::size_t chunk_count = detail::for_each_chunk(size, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t chunk)
+      {
+         interpolate_linear(std::span(data + begin, data + end));
+         edges[chunk] = detail::edges_of(data, begin, end);
+         chunk_begins[chunk] = begin;
+      });
+
+      // Pairs of the value before and the value after each gap
+      std::vector<std::size_t> gaps;
+      std::size_t previous = size;
+      for (std::size_t chunk = 0; chunk < chunk_count; ++chunk)
+      {
+         const std::size_t begin = chunk_begins[chunk];
+         const std::size_t end = chunk + 1 < chunk_count ? chunk_begins[chunk + 1] : size;
+         if (edges[chunk].leading_nulls == end - begin)
+         {
+            continue;
+         }
+         const std::size_t first = begin + edges[chunk].leading_nulls;
+         if (previous != size && first - previous > 1)
+         {
+            gaps.push_back(previous);
+            gaps.push_back(first);
+         }
+         previous = end - 1 - edges[chunk].trailing_nulls;
+      }
+
+      detail::for_each_chunk(gaps.size() / 2, thread_count, [&](const std::size_t begin, const std::size_t end, const std::size_t)
+      {
+         for (std::size_t gap = begin; gap < end; ++gap)
+         {
+            detail::interpolate_gap(data + gaps[2 * gap], gaps[2 * gap + 1] - gaps[2 * gap]);
+         }
+      });
+   }
+
+} // namespace io
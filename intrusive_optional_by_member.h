@@ -0,0 +1,273 @@
+#pragma once
+
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "intrusive_optional.h"
+
+
+namespace io
+{
+
+   template <typename T>
+   struct member_pointer_traits;
+
+   template <typename class_type_param, typename member_type_param>
+   struct member_pointer_traits<member_type_param class_type_param::*>
+   {
+      using class_type = class_type_param;
+      using member_type = member_type_param;
+   };
+
+
+   // Optional record where one field holds the null state, e.g. intrusive_optional_by_member<&record::id, -1>.
+   // Null checks, reset() and the safety checks only touch that field, so they cost a single compare
+   // regardless of the record size, and the record doesn't need to be a structural type.
+   // Null records are value-initialized with the field set to the null value. reset() only writes
+   // the field and leaves the rest of the record as it is. The safety modes and failures work like in
+   // intrusive_optional: debug has the API of unsafe and the checks of safe where IO_DEBUG_CHECKS is 1.
+   template <auto member, auto null_member_value, safety_mode_t safety_mode = safety_mode_t::unsafe,
+      typename failure_policy = throw_on_failure>
+   requires std::is_member_object_pointer_v<decltype(member)>
+   struct intrusive_optional_by_member
+   {
+      using value_type = typename member_pointer_traits<decltype(member)>::class_type;
+      using member_type = typename member_pointer_traits<decltype(member)>::member_type;
+
+      constexpr inline static member_type null_value{ null_member_value };
+   private:
+      value_type m_value;
+
+      static constexpr bool null_checks = safety_mode == safety_mode_t::safe
+         || (safety_mode == safety_mode_t::debug && IO_DEBUG_CHECKS);
+      static constexpr bool access_checks = safety_mode == safety_mode_t::debug && IO_DEBUG_CHECKS;
+
+      static constexpr bool nothrow_checks = null_checks == false
+         || noexcept(failure_policy::fail(optional_errc::unintentionally_null));
+      static constexpr bool nothrow_access = access_checks == false
+         || noexcept(failure_policy::fail(optional_errc::bad_access));
+
+   public:
+
+      // Constructors
+      constexpr intrusive_optional_by_member() noexcept(std::is_nothrow_default_constructible_v<value_type>)
+         : m_value{}
+      {
+         m_value.*member = null_value;
+      }
+
+      constexpr intrusive_optional_by_member(std::nullopt_t) noexcept(std::is_nothrow_default_constructible_v<value_type>)
+         : intrusive_optional_by_member()
+      { }
+
+      template<typename ... Args>
+      requires std::is_constructible_v<value_type, Args...>
+      constexpr explicit intrusive_optional_by_member(std::in_place_t, Args&&... args)
+         : m_value(std::forward<Args>(args)...)
+      {
+         this->ensure_not_zero();
+      }
+
+      template <typename U = value_type>
+      requires (std::is_constructible_v<value_type, U>
+         && std::is_same_v<std::remove_cvref_t<U>, std::in_place_t> == false
+         && std::is_same_v<std::remove_cvref_t<U>, intrusive_optional_by_member> == false)
+      constexpr explicit(not std::is_convertible_v<U, value_type>) intrusive_optional_by_member(U&& u)
+         noexcept(std::is_nothrow_constructible_v<value_type, U> && nothrow_checks)
+         : m_value(std::forward<U>(u))
+      {
+         this->ensure_not_zero();
+      }
+
+
+
+      // Assignment of a value
+      template <typename U = value_type>
+      requires (std::is_same_v<std::remove_cvref_t<U>, intrusive_optional_by_member> == false
+         && std::is_assignable_v<value_type&, U>)
+      constexpr auto operator=(U&& u) -> intrusive_optional_by_member&
+      {
+         m_value = std::forward<U>(u);
+         this->ensure_not_zero();
+         return *this;
+      }
+
+      constexpr auto operator=(std::nullopt_t) noexcept(std::is_nothrow_copy_assignable_v<member_type>) -> intrusive_optional_by_member&
+      {
+         this->reset();
+         return *this;
+      }
+
+
+
+      // Observers
+      constexpr auto has_value() const noexcept -> bool
+      {
+         return detail::is_null_value<null_value>(m_value.*member) == false;
+      }
+
+      explicit constexpr operator bool() const noexcept
+      {
+         return this->has_value();
+      }
+
+      constexpr auto operator->() const noexcept(nothrow_access) -> const value_type*
+      {
+         this->ensure_accessible();
+         return ::std::addressof(m_value);
+      }
+
+      constexpr auto operator->() noexcept(nothrow_access) -> value_type*
+         requires(safety_mode != safety_mode_t::safe)
+      {
+         this->ensure_accessible();
+         return ::std::addressof(m_value);
+      }
+
+      constexpr auto operator*() const& noexcept(nothrow_access) -> const value_type&
+      {
+         this->ensure_accessible();
+         return m_value;
+      }
+
+      constexpr auto operator*() & noexcept(nothrow_access) -> value_type&
+         requires(safety_mode != safety_mode_t::safe)
+      {
+         this->ensure_accessible();
+         return m_value;
+      }
+
+      constexpr auto operator*() && noexcept(nothrow_access) -> value_type&&
+         requires(safety_mode != safety_mode_t::safe)
+      {
+         this->ensure_accessible();
+         return ::std::move(m_value);
+      }
+
+      constexpr auto value() const& -> const value_type&
+      {
+         if (this->has_value() == false)
+         {
+            failure_policy::fail(optional_errc::bad_access);
+         }
+         return m_value;
+      }
+
+      constexpr auto value() & -> value_type&
+         requires(safety_mode != safety_mode_t::safe)
+      {
+         if (this->has_value() == false)
+         {
+            failure_policy::fail(optional_errc::bad_access);
+         }
+         return m_value;
+      }
+
+      template <typename T>
+      requires (std::is_copy_constructible_v<value_type> && std::is_convertible_v<T&&, value_type>)
+      constexpr auto value_or(T&& default_value) const& -> value_type
+      {
+         if (this->has_value())
+         {
+            return m_value;
+         }
+         return static_cast<value_type>(::std::forward<T>(default_value));
+      }
+
+      [[nodiscard]] constexpr auto get_std() const -> std::optional<value_type>
+      {
+         if (this->has_value() == false)
+         {
+            return std::nullopt;
+         }
+         return m_value;
+      }
+
+
+
+      // Modifiers. A throwing constructor builds the new record aside first, so a failed emplace()
+      // leaves the old record in place instead of a destroyed one.
+      template <typename ... Args>
+      requires (std::is_nothrow_constructible_v<value_type, Args...>
+         || (std::is_constructible_v<value_type, Args...> && std::is_move_assignable_v<value_type>))
+      constexpr auto emplace(Args&&... args) -> value_type&
+      {
+         if constexpr (std::is_nothrow_constructible_v<value_type, Args...>)
+         {
+            std::destroy_at(std::addressof(m_value));
+            std::construct_at(std::addressof(m_value), std::forward<Args>(args)...);
+         }
+         else
+         {
+            m_value = value_type(std::forward<Args>(args)...);
+         }
+         this->ensure_not_zero();
+         return m_value;
+      }
+
+      // Only writes the null field
+      constexpr auto reset() noexcept(std::is_nothrow_copy_assignable_v<member_type>) -> void
+      {
+         m_value.*member = null_value;
+      }
+
+      constexpr auto swap(intrusive_optional_by_member& other)
+         noexcept(std::is_nothrow_swappable_v<value_type>) -> void
+      {
+         using std::swap;
+         swap(m_value, other.m_value);
+      }
+
+
+
+      // Comparisons. Null records are equal regardless of their other fields.
+      friend constexpr auto operator==(const intrusive_optional_by_member& lhs, const intrusive_optional_by_member& rhs) -> bool
+         requires requires { bool(*lhs == *rhs); }
+      {
+         if (lhs.has_value() != rhs.has_value())
+            return false;
+         if (lhs.has_value() == false)
+            return true;
+         return *lhs == *rhs;
+      }
+
+      friend constexpr auto operator==(const intrusive_optional_by_member& opt, std::nullopt_t) noexcept -> bool
+      {
+         return opt.has_value() == false;
+      }
+
+
+
+   private:
+      constexpr auto ensure_not_zero() const -> void
+      {
+         if constexpr (null_checks)
+         {
+            if (this->has_value() == false)
+            {
+               failure_policy::fail(optional_errc::unintentionally_null);
+            }
+         }
+      }
+
+      constexpr auto ensure_accessible() const noexcept(nothrow_access) -> void
+      {
+         if constexpr (access_checks)
+         {
+            if (this->has_value() == false)
+            {
+               failure_policy::fail(optional_errc::bad_access);
+            }
+         }
+      }
+   };
+
+
+   template <auto member, auto null_member_value, safety_mode_t safety_mode, typename failure_policy>
+   struct is_trivially_relocatable<intrusive_optional_by_member<member, null_member_value, safety_mode, failure_policy>>
+      : is_trivially_relocatable<typename intrusive_optional_by_member<member, null_member_value, safety_mode, failure_policy>::value_type> {};
+
+} // namespace io
@@ -0,0 +1,379 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "intrusive_optional_algorithms.h"
+
+
+// Block-wise codecs for columns of intrusive_optionals. Each encoder compresses one block (any
+// contiguous range), larger columns are meant to be split into blocks by the caller. All decoders
+// write directly into a column of the same intrusive_optional type: Null elements are restored by
+// writing the sentinel, so there's no separate validity pass.
+namespace io
+{
+
+   struct codec_size_mismatch final : std::length_error
+   {
+      codec_size_mismatch()
+         : std::length_error("The output column size doesn't match the size of the encoded block.")
+      { }
+   };
+
+
+   namespace detail
+   {
+
+      template <typename T>
+      using unsigned_t = std::make_unsigned_t<T>;
+
+
+      // Codes of a fixed bit width packed into 64-bit words. There's always one padding word at the
+      // end so that reading the word after the current one never needs a bounds check.
+      struct bit_packed_codes
+      {
+         std::vector<std::uint64_t> words;
+         int bits = 0;
+
+         constexpr bit_packed_codes() = default;
+
+         constexpr bit_packed_codes(const std::size_t size, const int bit_width)
+            : words(size * static_cast<std::size_t>(bit_width) / 64 + 2, 0)
+            , bits(bit_width)
+         { }
+
+         constexpr auto set(const std::size_t index, const std::uint64_t code) -> void
+         {
+            const std::size_t position = index * static_cast<std::size_t>(this->bits);
+            const std::size_t word = position / 64;
+            const int shift = static_cast<int>(position % 64);
+            this->words[word] |= code << shift;
+            if (shift + this->bits > 64)
+            {
+               this->words[word + 1] |= code >> (64 - shift);
+            }
+         }
+
+         [[nodiscard]] constexpr auto get(const std::size_t index) const -> std::uint64_t
+         {
+            const std::size_t position = index * static_cast<std::size_t>(this->bits);
+            const std::size_t word = position / 64;
+            const int shift = static_cast<int>(position % 64);
+            const std::uint64_t low = this->words[word] >> shift;
+
+            // Two shifts because a single shift by 64 is undefined
+            const std::uint64_t high = (this->words[word + 1] << (63 - shift)) << 1;
+            return (low | high) & this->mask();
+         }
+
+         [[nodiscard]] constexpr auto mask() const -> std::uint64_t
+         {
+            return this->bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << this->bits) - 1;
+         }
+
+         [[nodiscard]] constexpr auto size_in_bytes() const -> std::size_t
+         {
+            return this->words.size() * sizeof(std::uint64_t);
+         }
+      };
+
+
+      template <typename output_type>
+      constexpr auto ensure_output_size(const output_type& output, const std::size_t size) -> void
+      {
+         if (std::ranges::size(output) != size)
+         {
+            throw codec_size_mismatch{};
+         }
+      }
+
+
+      // Order of the dictionary. Floating-point values use std::strong_order, a total order in
+      // which NaNs are ordinary values that sort and deduplicate like any other. operator< isn't a
+      // strict weak ordering with NaNs.
+      struct dictionary_less
+      {
+         template <typename T>
+         [[nodiscard]] constexpr auto operator()(const T& lhs, const T& rhs) const -> bool
+         {
+            if constexpr (std::is_floating_point_v<T>)
+               return std::strong_order(lhs, rhs) < 0;
+            else
+               return lhs < rhs;
+         }
+      };
+
+      struct dictionary_equal
+      {
+         template <typename T>
+         [[nodiscard]] constexpr auto operator()(const T& lhs, const T& rhs) const -> bool
+         {
+            if constexpr (std::is_floating_point_v<T>)
+               return std::strong_order(lhs, rhs) == 0;
+            else
+               return lhs == rhs;
+         }
+      };
+
+   } // namespace detail
+
+
+
+   // Null-run RLE: Alternating run lengths of nulls and values, always starting with a null run
+   // (which may be empty). Only the engaged values are stored.
+   template <auto null_value>
+   struct null_run_block
+   {
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+
+      std::size_t size = 0;
+      std::vector<std::uint32_t> runs;
+      std::vector<value_type> values;
+
+      [[nodiscard]] constexpr auto size_in_bytes() const -> std::size_t
+      {
+         return this->runs.size() * sizeof(std::uint32_t) + this->values.size() * sizeof(value_type);
+      }
+   };
+
+
+   template <optional_column R, typename opt_type = column_optional_t<R>>
+   [[nodiscard]] constexpr auto encode_null_runs(R&& column) -> null_run_block<opt_type::null_value>
+   {
+      const auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      null_run_block<opt_type::null_value> result;
+      result.size = size;
+      std::size_t i = 0;
+      while (i < size)
+      {
+         const std::size_t null_begin = i;
+         while (i < size && detail::is_null(data[i]))
+            ++i;
+         result.runs.push_back(static_cast<std::uint32_t>(i - null_begin));
+
+         const std::size_t value_begin = i;
+         while (i < size && detail::is_null(data[i]) == false)
+         {
+            result.values.push_back(detail::raw(data[i]));
+            ++i;
+         }
+         result.runs.push_back(static_cast<std::uint32_t>(i - value_begin));
+      }
+      return result;
+   }
+
+
+   // Decodes into columns with the null_value of the block, in any safety mode and with any policies
+   template <auto null_value, mutable_optional_column R>
+   requires std::is_same_v<intrusive_optional<column_optional_t<R>::null_value>, intrusive_optional<null_value>>
+   constexpr auto decode_null_runs(const null_run_block<null_value>& block, R&& output) -> void
+   {
+      detail::ensure_output_size(output, block.size);
+      auto* out = std::ranges::data(output);
+      const auto* values = block.values.data();
+
+      // Both inner loops are plain fill/copy loops, which is what gets vectorized
+      for (std::size_t run = 0; run < block.runs.size(); run += 2)
+      {
+         const std::uint32_t null_count = block.runs[run];
+         for (std::uint32_t j = 0; j < null_count; ++j)
+         {
+            detail::raw(out[j]) = null_value;
+         }
+         out += null_count;
+
+         const std::uint32_t value_count = block.runs[run + 1];
+         for (std::uint32_t j = 0; j < value_count; ++j)
+         {
+            detail::raw(out[j]) = values[j];
+         }
+         out += value_count;
+         values += value_count;
+      }
+   }
+
+
+
+   // Frame of reference: Values are stored as bit-packed deltas to the smallest engaged value. The
+   // largest code of the bit width is reserved for null. Only available for integral value types.
+   template <auto null_value>
+   requires std::is_integral_v<decltype(null_value)>
+   struct frame_of_reference_block
+   {
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+
+      std::size_t size = 0;
+      value_type reference{};
+      std::uint64_t null_code = 0;
+      detail::bit_packed_codes codes;
+
+      [[nodiscard]] constexpr auto size_in_bytes() const -> std::size_t
+      {
+         return sizeof(value_type) + sizeof(std::uint64_t) + this->codes.size_in_bytes();
+      }
+   };
+
+
+   template <optional_column R, typename opt_type = column_optional_t<R>>
+   requires std::is_integral_v<typename opt_type::value_type>
+   [[nodiscard]] constexpr auto encode_frame_of_reference(R&& column) -> frame_of_reference_block<opt_type::null_value>
+   {
+      using value_type = typename opt_type::value_type;
+      using unsigned_type = detail::unsigned_t<value_type>;
+      const auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      value_type min = std::numeric_limits<value_type>::max();
+      value_type max = std::numeric_limits<value_type>::min();
+      bool any_value = false;
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         if (detail::is_null(data[i]) == false)
+         {
+            min = std::min(min, detail::raw(data[i]));
+            max = std::max(max, detail::raw(data[i]));
+            any_value = true;
+         }
+      }
+      if (any_value == false)
+      {
+         min = max = value_type{};
+      }
+
+      frame_of_reference_block<opt_type::null_value> result;
+      result.size = size;
+      result.reference = min;
+
+      const unsigned_type max_delta = static_cast<unsigned_type>(static_cast<unsigned_type>(max) - static_cast<unsigned_type>(min));
+      int bits = 0;
+      if (max_delta == std::numeric_limits<unsigned_type>::max())
+      {
+         // The frame spans the whole value range and therefore contains the null value itself. Its
+         // own delta then doubles as the null code.
+         bits = std::numeric_limits<unsigned_type>::digits;
+         result.null_code = static_cast<unsigned_type>(static_cast<unsigned_type>(opt_type::null_value) - static_cast<unsigned_type>(min));
+      }
+      else
+      {
+         bits = std::max(1, static_cast<int>(std::bit_width(static_cast<std::uint64_t>(max_delta) + 1)));
+         result.null_code = bits == 64 ? ~std::uint64_t{ 0 } : (std::uint64_t{ 1 } << bits) - 1;
+      }
+
+      result.codes = detail::bit_packed_codes(size, bits);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         const std::uint64_t delta = static_cast<unsigned_type>(static_cast<unsigned_type>(detail::raw(data[i])) - static_cast<unsigned_type>(min));
+         result.codes.set(i, detail::is_null(data[i]) == false ? delta : result.null_code);
+      }
+      return result;
+   }
+
+
+   template <auto null_value, mutable_optional_column R>
+   requires std::is_same_v<intrusive_optional<column_optional_t<R>::null_value>, intrusive_optional<null_value>>
+   constexpr auto decode_frame_of_reference(const frame_of_reference_block<null_value>& block, R&& output) -> void
+   {
+      using value_type = decltype(null_value);
+      using unsigned_type = detail::unsigned_t<value_type>;
+      detail::ensure_output_size(output, block.size);
+      auto* out = std::ranges::data(output);
+
+      // Branch-free select between the sentinel and the decoded value
+      const unsigned_type reference = static_cast<unsigned_type>(block.reference);
+      for (std::size_t i = 0; i < block.size; ++i)
+      {
+         const std::uint64_t code = block.codes.get(i);
+         const value_type decoded = static_cast<value_type>(static_cast<unsigned_type>(reference + static_cast<unsigned_type>(code)));
+         detail::raw(out[i]) = code == block.null_code ? null_value : decoded;
+      }
+   }
+
+
+
+   // Dictionary: The sorted distinct engaged values, preceded by the null value at code 0. Codes are
+   // bit-packed. Decoding is a plain gather without any special case for null.
+   template <auto null_value>
+   struct dictionary_block
+   {
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+
+      static constexpr inline std::uint64_t null_code = 0;
+
+      std::size_t size = 0;
+      std::vector<value_type> dictionary;
+      detail::bit_packed_codes codes;
+
+      [[nodiscard]] constexpr auto size_in_bytes() const -> std::size_t
+      {
+         return this->dictionary.size() * sizeof(value_type) + this->codes.size_in_bytes();
+      }
+   };
+
+
+   template <optional_column R, typename opt_type = column_optional_t<R>>
+   requires requires(const typename opt_type::value_type& v) { bool(v < v); }
+   [[nodiscard]] constexpr auto encode_dictionary(R&& column) -> dictionary_block<opt_type::null_value>
+   {
+      using value_type = typename opt_type::value_type;
+      const auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+
+      std::vector<value_type> distinct;
+      distinct.reserve(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         if (detail::is_null(data[i]) == false)
+         {
+            distinct.push_back(detail::raw(data[i]));
+         }
+      }
+      std::ranges::sort(distinct, detail::dictionary_less{});
+      const auto duplicates = std::ranges::unique(distinct, detail::dictionary_equal{});
+      distinct.erase(duplicates.begin(), duplicates.end());
+
+      dictionary_block<opt_type::null_value> result;
+      result.size = size;
+      result.dictionary.reserve(distinct.size() + 1);
+      result.dictionary.push_back(opt_type::null_value);
+      result.dictionary.insert(result.dictionary.end(), distinct.begin(), distinct.end());
+
+      const int bits = std::max(1, static_cast<int>(std::bit_width(distinct.size())));
+      result.codes = detail::bit_packed_codes(size, bits);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         if (detail::is_null(data[i]) == false)
+         {
+            const auto it = std::ranges::lower_bound(distinct, detail::raw(data[i]), detail::dictionary_less{});
+            result.codes.set(i, static_cast<std::uint64_t>(it - distinct.begin()) + 1);
+         }
+      }
+      return result;
+   }
+
+
+   template <auto null_value, mutable_optional_column R>
+   requires std::is_same_v<intrusive_optional<column_optional_t<R>::null_value>, intrusive_optional<null_value>>
+   constexpr auto decode_dictionary(const dictionary_block<null_value>& block, R&& output) -> void
+   {
+      detail::ensure_output_size(output, block.size);
+      auto* out = std::ranges::data(output);
+      const auto* dictionary = block.dictionary.data();
+      for (std::size_t i = 0; i < block.size; ++i)
+      {
+         detail::raw(out[i]) = dictionary[block.codes.get(i)];
+      }
+   }
+
+} // namespace io
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+#include "intrusive_optional.h"
+
+
+// io::compact_optional<T> picks the null value of an intrusive_optional automatically from a niche
+// of T: a value that T never holds in practice.
+namespace io
+{
+
+   // Niche of a type. Specialize with a static constexpr T null_value for domain types:
+   // template <> struct io::niche_traits<my_id> { static constexpr my_id null_value{ 0 }; };
+   template <typename T>
+   struct niche_traits {};
+
+   template <typename T>
+   concept has_niche = requires { { niche_traits<T>::null_value } -> std::convertible_to<T>; };
+
+
+   // Pointers: nullptr
+   template <typename T>
+   requires std::is_pointer_v<T>
+   struct niche_traits<T>
+   {
+      static constexpr T null_value = nullptr;
+   };
+
+
+   // Floating-point types: The canonical quiet NaN. intrusive_optional compares it bitwise, so other
+   // NaNs are still values.
+   template <typename T>
+   requires (std::is_floating_point_v<T> && std::numeric_limits<T>::has_quiet_NaN && (sizeof(T) == 4 || sizeof(T) == 8))
+   struct niche_traits<T>
+   {
+      static constexpr T null_value = std::numeric_limits<T>::quiet_NaN();
+   };
+
+
+   namespace detail
+   {
+
+      template <auto value>
+      consteval auto enumerator_signature() -> std::string_view
+      {
+#if defined(_MSC_VER) && !defined(__clang__)
+         return __FUNCSIG__;
+#else
+         return __PRETTY_FUNCTION__;
+#endif
+      }
+
+      // Whether the value has an enumerator. Compilers print enumerators by name in function
+      // signatures and other values as a cast like (E)5.
+      template <auto value>
+      consteval auto is_enumerator() -> bool
+      {
+         const std::string_view signature = enumerator_signature<value>();
+#if defined(_MSC_VER) && !defined(__clang__)
+         const std::size_t position = signature.find("enumerator_signature<") + std::string_view("enumerator_signature<").size();
+#else
+         const std::size_t position = signature.find("value = ") + std::string_view("value = ").size();
+#endif
+         return signature[position] != '(';
+      }
+
+
+      // Scoped enums have a fixed underlying type, so every value of it is a valid enum value
+      template <typename E>
+      concept scoped_enum = std::is_enum_v<E> && std::is_convertible_v<E, std::underlying_type_t<E>> == false;
+
+      // Values near the maximum and minimum of the underlying type are tried
+      constexpr inline int enum_niche_candidates = 64;
+
+      template <scoped_enum E, int i = 0>
+      consteval auto find_enum_niche() -> std::optional<E>
+      {
+         using underlying_type = std::underlying_type_t<E>;
+         if constexpr (i == 2 * enum_niche_candidates)
+         {
+            return std::nullopt;
+         }
+         else
+         {
+            constexpr underlying_type max = std::numeric_limits<underlying_type>::max();
+            constexpr underlying_type min = std::numeric_limits<underlying_type>::min();
+            constexpr underlying_type candidate = i % 2 == 0
+               ? static_cast<underlying_type>(max - static_cast<underlying_type>(i / 2))
+               : static_cast<underlying_type>(min + static_cast<underlying_type>(i / 2));
+            if constexpr (is_enumerator<static_cast<E>(candidate)>() == false)
+            {
+               return static_cast<E>(candidate);
+            }
+            else
+            {
+               return find_enum_niche<E, i + 1>();
+            }
+         }
+      }
+
+   } // namespace detail
+
+
+   // Scoped enums: The first value near the ends of the underlying type that has no enumerator.
+   // Unscoped enums need a niche_traits specialization.
+   template <detail::scoped_enum E>
+   requires (detail::find_enum_niche<E>().has_value())
+   struct niche_traits<E>
+   {
+      static constexpr E null_value = *detail::find_enum_niche<E>();
+   };
+
+
+
+   // Whether compact_optional may use std::optional for types without niche
+   enum class niche_fallback { none, std_optional };
+
+   namespace detail
+   {
+
+      template <typename T, niche_fallback fallback>
+      struct compact_optional_type
+      {
+         static_assert(fallback == niche_fallback::std_optional,
+            "T has no niche. Specialize io::niche_traits<T> or opt in to io::niche_fallback::std_optional.");
+         using type = std::optional<T>;
+      };
+
+      template <has_niche T, niche_fallback fallback>
+      struct compact_optional_type<T, fallback>
+      {
+         using type = intrusive_optional<niche_traits<T>::null_value>;
+      };
+
+   } // namespace detail
+
+
+   // intrusive_optional with the niche of T as null value. Types without niche are a compile error,
+   // unless std::optional is explicitly allowed as fallback.
+   template <typename T, niche_fallback fallback = niche_fallback::none>
+   using compact_optional = typename detail::compact_optional_type<T, fallback>::type;
+
+} // namespace io
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "intrusive_optional_algorithms.h"
+
+
+// Conversion of whole columns between intrusive_optionals of different value types or sentinels,
+// e.g. from intrusive_optional<std::int64_t{-1}> to intrusive_optional<std::numeric_limits<std::int32_t>::max()>.
+// Unlike the converting constructor per element, source nulls become destination nulls with a
+// select instead of a branch, so the loops vectorize.
+namespace io
+{
+
+   // What happens to values outside the range of the destination type
+   enum class overflow_policy
+   {
+      saturate, // Clamped to the destination range
+      checked   // conversion_overflow is thrown after the conversion
+   };
+
+   struct conversion_overflow final : std::range_error
+   {
+      conversion_overflow()
+         : std::range_error("A value is out of the range of the destination type.")
+      { }
+   };
+
+
+   struct conversion_report
+   {
+      // Values outside the destination range. NaNs converted to integers count as out of range and,
+      // since they become null, as collisions.
+      std::size_t out_of_range_count = 0;
+
+      // Values that became equal to the null_value of the destination and are therefore null now
+      std::size_t collision_count = 0;
+
+      constexpr auto operator==(const conversion_report&) const -> bool = default;
+   };
+
+
+   namespace detail
+   {
+
+      template <typename T>
+      concept convertible_arithmetic = std::is_arithmetic_v<T> && std::is_same_v<T, bool> == false;
+
+
+      // Value converted to the destination type with saturation. out_of_range is set if it had to be
+      // clamped. NaNs converted to integers become nan_result. Every case is written as selects.
+      template <convertible_arithmetic to_type, convertible_arithmetic from_type>
+      [[nodiscard]] constexpr auto saturating_convert(const from_type value, const to_type nan_result, bool& out_of_range) -> to_type
+      {
+         using to_limits = std::numeric_limits<to_type>;
+         if constexpr (std::is_floating_point_v<to_type>)
+         {
+            if constexpr (std::is_floating_point_v<from_type> && sizeof(from_type) > sizeof(to_type))
+            {
+               // NaNs stay NaNs
+               const bool above = value > static_cast<from_type>(to_limits::max());
+               const bool below = value < static_cast<from_type>(to_limits::lowest());
+               out_of_range = above | below;
+               return above ? to_limits::max() : below ? to_limits::lowest() : static_cast<to_type>(value);
+            }
+            else
+            {
+               out_of_range = false;
+               return static_cast<to_type>(value);
+            }
+         }
+         else if constexpr (std::is_floating_point_v<from_type>)
+         {
+            // Both bounds are powers of two and exact. The upper one is exclusive.
+            constexpr from_type lower = static_cast<from_type>(to_limits::min());
+            constexpr from_type upper = static_cast<from_type>(to_limits::max() / 2 + 1) * 2;
+            const bool is_nan = value != value;
+            const bool above = value >= upper;
+            const bool below = value < lower;
+            const bool in_range = (is_nan | above | below) == false;
+            out_of_range = in_range == false;
+            const to_type converted = static_cast<to_type>(in_range ? value : from_type{});
+            return is_nan ? nan_result : above ? to_limits::max() : below ? to_limits::min() : converted;
+         }
+         else if constexpr (std::in_range<to_type>(std::numeric_limits<from_type>::min())
+            && std::in_range<to_type>(std::numeric_limits<from_type>::max()))
+         {
+            out_of_range = false;
+            return static_cast<to_type>(value);
+         }
+         else
+         {
+            // Clamped in the source type to the limits of the destination that it can represent. A
+            // min and max per value, which vectorize.
+            using from_limits = std::numeric_limits<from_type>;
+            constexpr from_type lower = std::cmp_less(to_limits::min(), from_limits::min()) ? from_limits::min() : static_cast<from_type>(to_limits::min());
+            constexpr from_type upper = std::cmp_greater(to_limits::max(), from_limits::max()) ? from_limits::max() : static_cast<from_type>(to_limits::max());
+            const from_type clamped = std::min(std::max(value, lower), upper);
+            out_of_range = clamped != value;
+            return static_cast<to_type>(clamped);
+         }
+      }
+
+   } // namespace detail
+
+
+   // Converts input into output of the same size. Nulls stay null. Values that end up equal to the
+   // destination's null_value become null too and are counted as collisions, this includes values
+   // saturated onto it. With overflow_policy::checked, the output is fully written before
+   // conversion_overflow is thrown.
+   template <overflow_policy policy = overflow_policy::saturate, optional_column input_type, mutable_optional_column output_type>
+   requires (detail::convertible_arithmetic<column_value_t<input_type>> && detail::convertible_arithmetic<column_value_t<output_type>>)
+   auto convert_column(input_type&& input, output_type&& output) -> conversion_report
+   {
+      using to_type = column_value_t<output_type>;
+      constexpr to_type null_value = column_optional_t<output_type>::null_value;
+
+      const std::size_t size = std::ranges::size(input);
+      if (std::ranges::size(output) != size)
+      {
+         throw std::length_error("The output column must have the size of the input column.");
+      }
+      const auto* in = std::ranges::data(input);
+      auto* out = std::ranges::data(output);
+
+      // Collisions are the nulls of the output that weren't null in the input. They're counted in a
+      // second pass over each block while it's still in the L1 cache, because a compare of the
+      // destination type in the first loop mixes vector widths and stops it from vectorizing.
+      constexpr std::size_t block_size = 1024;
+      std::size_t out_of_range_count = 0;
+      std::size_t input_null_count = 0;
+      std::size_t output_null_count = 0;
+      for (std::size_t begin = 0; begin < size; begin += block_size)
+      {
+         const std::size_t end = std::min(begin + block_size, size);
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            const bool is_value = detail::is_null(in[i]) == false;
+            bool out_of_range = false;
+            const to_type converted = detail::saturating_convert<to_type>(detail::raw(in[i]), null_value, out_of_range);
+            detail::raw(out[i]) = is_value ? converted : null_value;
+            out_of_range_count += static_cast<std::size_t>(is_value & out_of_range);
+            input_null_count += static_cast<std::size_t>(is_value == false);
+         }
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            output_null_count += static_cast<std::size_t>(detail::is_null(out[i]));
+         }
+      }
+      const conversion_report report{ out_of_range_count, output_null_count - input_null_count };
+
+      if constexpr (policy == overflow_policy::checked)
+      {
+         if (report.out_of_range_count > 0)
+         {
+            throw conversion_overflow{};
+         }
+      }
+      return report;
+   }
+
+} // namespace io
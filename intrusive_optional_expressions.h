@@ -0,0 +1,264 @@
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "intrusive_optional_algorithms.h"
+
+
+// Lazy, null-propagating arithmetic over columns of intrusive_optionals. An expression like
+// io::col(a) * io::col(b) + io::col(c) builds a tree of expression objects. Nothing is computed until
+// io::evaluate() writes the whole expression into an output column in a single pass.
+//
+// The result is null if any input is null. Validity is combined with non-short-circuiting ands of
+// the input sentinel compares and the value is computed unconditionally, so the loop has no
+// branches. Null inputs take part in the arithmetic as a neutral zero (and as one for divisors) to
+// keep the computation free of overflow on sentinels. Integer divisions by zero and of the minimum
+// by -1 are undefined, their results are null.
+namespace io
+{
+
+   struct expression_size_mismatch final : std::length_error
+   {
+      expression_size_mismatch()
+         : std::length_error("The columns of an expression must have the same size.")
+      { }
+   };
+
+
+   // Result of an expression for one element. Validity and value are computed together, so every
+   // subexpression is evaluated once per element however deeply it's nested.
+   template <typename T>
+   struct expression_value
+   {
+      T value;
+      bool valid;
+   };
+
+   template <typename T>
+   concept column_expression = requires(const T & expression, std::size_t i)
+   {
+      { expression.size() } -> std::convertible_to<std::size_t>;
+      { expression.eval(i).valid } -> std::convertible_to<bool>;
+      expression.eval(i).value;
+      typename T::is_column_expression;
+   };
+
+
+   template <typename opt_type>
+   struct column_leaf
+   {
+      using is_column_expression = void;
+      using value_type = typename opt_type::value_type;
+
+      const opt_type* m_data;
+      std::size_t m_size;
+
+      [[nodiscard]] constexpr auto size() const -> std::size_t
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] constexpr auto eval(const std::size_t i) const -> expression_value<value_type>
+      {
+         const value_type& raw = detail::raw(m_data[i]);
+         const bool is_null = detail::is_null_value<opt_type::null_value>(raw);
+         return { is_null ? value_type{} : raw, is_null == false };
+      }
+   };
+
+
+   template <typename T>
+   struct scalar_leaf
+   {
+      using is_column_expression = void;
+      using value_type = T;
+
+      T m_value;
+
+      // Scalars fit any size
+      [[nodiscard]] constexpr auto size() const -> std::size_t
+      {
+         return std::numeric_limits<std::size_t>::max();
+      }
+
+      [[nodiscard]] constexpr auto eval(std::size_t) const -> expression_value<T>
+      {
+         return { m_value, true };
+      }
+   };
+
+
+   namespace detail
+   {
+
+      // Whether lhs / rhs is defined. Only integer division by zero and the minimum divided by -1
+      // aren't.
+      template <typename lhs_value_type, typename rhs_value_type>
+      [[nodiscard]] constexpr auto is_defined_division(const lhs_value_type& lhs, const rhs_value_type& rhs) -> bool
+      {
+         using result_type = decltype(lhs / rhs);
+         if constexpr (std::is_integral_v<result_type>)
+         {
+            bool overflows = false;
+            if constexpr (std::is_signed_v<result_type>)
+            {
+               overflows = (static_cast<result_type>(lhs) == std::numeric_limits<result_type>::min())
+                  & (static_cast<result_type>(rhs) == result_type{ -1 });
+            }
+            return (static_cast<result_type>(rhs) != result_type{}) & (overflows == false);
+         }
+         else
+         {
+            return true;
+         }
+      }
+
+   } // namespace detail
+
+
+   template <typename op_type, column_expression lhs_type, column_expression rhs_type>
+   struct binary_expression
+   {
+      using is_column_expression = void;
+
+      lhs_type m_lhs;
+      rhs_type m_rhs;
+
+      constexpr binary_expression(const lhs_type& lhs, const rhs_type& rhs)
+         : m_lhs(lhs)
+         , m_rhs(rhs)
+      {
+         const bool lhs_is_scalar = lhs.size() == std::numeric_limits<std::size_t>::max();
+         const bool rhs_is_scalar = rhs.size() == std::numeric_limits<std::size_t>::max();
+         if (lhs_is_scalar == false && rhs_is_scalar == false && lhs.size() != rhs.size())
+         {
+            throw expression_size_mismatch{};
+         }
+      }
+
+      [[nodiscard]] constexpr auto size() const -> std::size_t
+      {
+         return std::min(m_lhs.size(), m_rhs.size());
+      }
+
+      [[nodiscard]] constexpr auto eval(const std::size_t i) const
+      {
+         const auto lhs = m_lhs.eval(i);
+         const auto rhs = m_rhs.eval(i);
+         if constexpr (std::is_same_v<op_type, std::divides<>>)
+         {
+            // Divisors of null or undefined results are replaced by one
+            using rhs_value_type = decltype(rhs.value);
+            const bool defined = detail::is_defined_division(lhs.value, rhs.value);
+            const bool valid = lhs.valid & rhs.valid & defined;
+            const auto value = op_type{}(lhs.value, rhs.valid & defined ? rhs.value : rhs_value_type{ 1 });
+            return expression_value<decltype(value)>{ value, valid };
+         }
+         else
+         {
+            const bool valid = lhs.valid & rhs.valid;
+            const auto value = op_type{}(lhs.value, rhs.value);
+            return expression_value<decltype(value)>{ value, valid };
+         }
+      }
+   };
+
+
+   namespace detail
+   {
+
+      template <typename T>
+      [[nodiscard]] constexpr auto to_expression(const T& operand)
+      {
+         if constexpr (column_expression<T>)
+         {
+            return operand;
+         }
+         else
+         {
+            return scalar_leaf<T>{ operand };
+         }
+      }
+
+      template <typename lhs_type, typename rhs_type>
+      concept expression_operands = (column_expression<lhs_type> || column_expression<rhs_type>)
+         && (column_expression<lhs_type> || std::is_arithmetic_v<lhs_type>)
+         && (column_expression<rhs_type> || std::is_arithmetic_v<rhs_type>);
+
+      template <typename op_type, typename lhs_type, typename rhs_type>
+      [[nodiscard]] constexpr auto make_binary(const lhs_type& lhs, const rhs_type& rhs)
+      {
+         using lhs_expression = decltype(to_expression(lhs));
+         using rhs_expression = decltype(to_expression(rhs));
+         return binary_expression<op_type, lhs_expression, rhs_expression>(to_expression(lhs), to_expression(rhs));
+      }
+
+   } // namespace detail
+
+
+   // Wraps a column as expression leaf. The column must outlive the expression.
+   template <optional_column R>
+   [[nodiscard]] constexpr auto col(R&& column) -> column_leaf<column_optional_t<R>>
+   {
+      return { std::ranges::data(column), std::ranges::size(column) };
+   }
+
+
+   template <typename lhs_type, typename rhs_type>
+   requires detail::expression_operands<lhs_type, rhs_type>
+   [[nodiscard]] constexpr auto operator+(const lhs_type& lhs, const rhs_type& rhs)
+   {
+      return detail::make_binary<std::plus<>>(lhs, rhs);
+   }
+
+   template <typename lhs_type, typename rhs_type>
+   requires detail::expression_operands<lhs_type, rhs_type>
+   [[nodiscard]] constexpr auto operator-(const lhs_type& lhs, const rhs_type& rhs)
+   {
+      return detail::make_binary<std::minus<>>(lhs, rhs);
+   }
+
+   template <typename lhs_type, typename rhs_type>
+   requires detail::expression_operands<lhs_type, rhs_type>
+   [[nodiscard]] constexpr auto operator*(const lhs_type& lhs, const rhs_type& rhs)
+   {
+      return detail::make_binary<std::multiplies<>>(lhs, rhs);
+   }
+
+   template <typename lhs_type, typename rhs_type>
+   requires detail::expression_operands<lhs_type, rhs_type>
+   [[nodiscard]] constexpr auto operator/(const lhs_type& lhs, const rhs_type& rhs)
+   {
+      return detail::make_binary<std::divides<>>(lhs, rhs);
+   }
+
+
+   // Evaluates the expression in one pass. Null results are written as the sentinel of the output
+   // type. Note that a computed value which happens to equal that sentinel reads as null as well.
+   template <column_expression expression_type, mutable_optional_column R>
+   constexpr auto evaluate(const expression_type& expression, R&& output) -> void
+   {
+      using opt_type = column_optional_t<R>;
+      using value_type = typename opt_type::value_type;
+      const std::size_t size = std::ranges::size(output);
+      if (expression.size() != size)
+      {
+         throw expression_size_mismatch{};
+      }
+
+      auto* out = std::ranges::data(output);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         const auto result = expression.eval(i);
+         const value_type value = static_cast<value_type>(result.value);
+         detail::raw(out[i]) = result.valid ? value : opt_type::null_value;
+      }
+   }
+
+} // namespace io
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <atomic>
+#include <cstdlib>
+
+#include "intrusive_optional.h"
+
+
+// Failure policies for builds without exceptions. They're the fourth template parameter:
+// io::intrusive_optional<-1, io::safety_mode_t::safe, io::no_telemetry, io::abort_on_failure>
+namespace io
+{
+
+   // Aborts on every failure
+   struct abort_on_failure
+   {
+      [[noreturn]] static auto fail(optional_errc) noexcept -> void
+      {
+         std::abort();
+      }
+   };
+
+
+   using failure_callback = void (*)(optional_errc);
+
+   namespace detail
+   {
+
+      inline auto failure_callback_storage() noexcept -> std::atomic<failure_callback>&
+      {
+         static std::atomic<failure_callback> callback{ nullptr };
+         return callback;
+      }
+
+   } // namespace detail
+
+   // Installs the callback of callback_on_failure for all threads and returns the previous one.
+   // nullptr removes it.
+   inline auto set_failure_callback(const failure_callback callback) noexcept -> failure_callback
+   {
+      return detail::failure_callback_storage().exchange(callback);
+   }
+
+
+   // Calls the callback installed with set_failure_callback(), e.g. to log and flush before the
+   // process ends. The callback isn't expected to return: If it does, or if there's none, this aborts.
+   struct callback_on_failure
+   {
+      [[noreturn]] static auto fail(const optional_errc error) noexcept -> void
+      {
+         if (const failure_callback callback = detail::failure_callback_storage().load(std::memory_order_acquire))
+         {
+            callback(error);
+         }
+         std::abort();
+      }
+   };
+
+} // namespace io
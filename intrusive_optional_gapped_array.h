@@ -0,0 +1,334 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "intrusive_optional_views.h"
+
+
+namespace io
+{
+
+   namespace detail
+   {
+
+      // First index in [0, size) for which is_before(index) is false. is_before must be true for a
+      // prefix of the range. The loop has a fixed number of iterations and a select instead of a
+      // branch, so it doesn't suffer from mispredictions.
+      template <typename fn_type>
+      [[nodiscard]] constexpr auto branchless_partition_point(std::size_t size, const fn_type& is_before) -> std::size_t
+      {
+         if (size == 0)
+         {
+            return 0;
+         }
+         std::size_t base = 0;
+         while (size > 1)
+         {
+            const std::size_t half = size / 2;
+            base = is_before(base + half) ? base + half : base;
+            size -= half;
+         }
+         return base + static_cast<std::size_t>(is_before(base));
+      }
+
+   } // namespace detail
+
+
+   // Sorted set in a packed memory array: The values are stored in order in an array of
+   // intrusive_optionals with null holes in between, so that inserts only move values up to the
+   // next hole. The array is divided into segments of segment_size slots. The values of each segment
+   // are at its start, followed by the holes. When a segment is full, the smallest enclosing window
+   // of segments that is below its density threshold is redistributed evenly. This gives amortized
+   // O(log^2 n) moves per insert while scans stay sequential. Failures go to failure_policy.
+   template <auto null_value, std::size_t segment_size = 32, typename failure_policy = throw_on_failure>
+   requires (std::is_arithmetic_v<decltype(null_value)> && segment_size > 1)
+   class gapped_sorted_array
+   {
+   public:
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+
+   private:
+      // Density thresholds of the windows: Full for single segments, root_density for the whole array
+      static constexpr double root_density = 0.75;
+      static constexpr double shrink_density = 0.125;
+
+      std::vector<optional_type> m_slots;
+      std::vector<std::size_t> m_counts;
+
+      // Smallest value of each segment. Empty segments have the minimum of the next non-empty one,
+      // or the maximum of the value_type at the end. That keeps the minimums sorted, so a segment is
+      // found with a binary search over them without touching the slots.
+      std::vector<value_type> m_minimums;
+
+      std::vector<value_type> m_buffer;
+      std::size_t m_size = 0;
+
+   public:
+      gapped_sorted_array() = default;
+
+      [[nodiscard]] auto size() const -> std::size_t
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] auto empty() const -> bool
+      {
+         return m_size == 0;
+      }
+
+      [[nodiscard]] auto capacity() const -> std::size_t
+      {
+         return m_slots.size();
+      }
+
+      // Slots including holes, which are null
+      [[nodiscard]] auto slots() const -> const std::vector<optional_type>&
+      {
+         return m_slots;
+      }
+
+      // The values in ascending order
+      [[nodiscard]] auto values() const -> auto
+      {
+         return m_slots | views::engaged;
+      }
+
+
+      [[nodiscard]] auto contains(const value_type& value) const -> bool
+      {
+         if (m_size == 0)
+         {
+            return false;
+         }
+         const std::size_t segment = this->find_segment(value);
+         const std::size_t position = this->lower_bound_in_segment(segment, value);
+         return position < m_counts[segment] && *m_slots[segment * segment_size + position] == value;
+      }
+
+
+      // Returns false if the value was already contained. Inserting the null_value fails with
+      // optional_errc::unintentionally_null.
+      auto insert(const value_type& value) -> bool
+      {
+         if (detail::is_null_value<null_value>(value))
+         {
+            failure_policy::fail(optional_errc::unintentionally_null);
+         }
+         if (m_slots.empty())
+         {
+            this->redistribute_all(1);
+         }
+
+         std::size_t segment = this->find_segment(value);
+         std::size_t position = this->lower_bound_in_segment(segment, value);
+         if (position < m_counts[segment] && *m_slots[segment * segment_size + position] == value)
+         {
+            return false;
+         }
+         if (m_counts[segment] == segment_size)
+         {
+            this->rebalance_for_insert(segment);
+            segment = this->find_segment(value);
+            position = this->lower_bound_in_segment(segment, value);
+         }
+
+         optional_type* data = m_slots.data() + segment * segment_size;
+         std::copy_backward(data + position, data + m_counts[segment], data + m_counts[segment] + 1);
+         *data[position] = value;
+         ++m_counts[segment];
+         ++m_size;
+         this->update_minimums(segment, segment + 1);
+         return true;
+      }
+
+
+      // Returns false if the value wasn't contained
+      auto erase(const value_type& value) -> bool
+      {
+         if (m_size == 0)
+         {
+            return false;
+         }
+         const std::size_t segment = this->find_segment(value);
+         const std::size_t position = this->lower_bound_in_segment(segment, value);
+         optional_type* data = m_slots.data() + segment * segment_size;
+         if (position >= m_counts[segment] || *data[position] != value)
+         {
+            return false;
+         }
+
+         std::copy(data + position + 1, data + m_counts[segment], data + position);
+         --m_counts[segment];
+         data[m_counts[segment]].reset();
+         --m_size;
+         this->update_minimums(segment, segment + 1);
+
+         const std::size_t segment_count = m_counts.size();
+         if (segment_count > 1 && static_cast<double>(m_size) < shrink_density * static_cast<double>(m_slots.size()))
+         {
+            this->redistribute_all(segment_count / 2);
+         }
+         return true;
+      }
+
+
+      // Calls fn(value) for all values in [lo, hi] in ascending order
+      template <typename fn_type>
+      auto scan(const value_type& lo, const value_type& hi, fn_type&& fn) const -> void
+      {
+         if (m_size == 0)
+         {
+            return;
+         }
+         std::size_t segment = this->find_segment(lo);
+         std::size_t position = this->lower_bound_in_segment(segment, lo);
+         for (; segment < m_counts.size(); ++segment, position = 0)
+         {
+            const optional_type* data = m_slots.data() + segment * segment_size;
+            for (; position < m_counts[segment]; ++position)
+            {
+               if (*data[position] > hi)
+               {
+                  return;
+               }
+               fn(*data[position]);
+            }
+         }
+      }
+
+
+      // Helpers
+   private:
+      // Last segment whose minimum isn't larger than the value, or the first segment. Empty segments
+      // can only be found at the very start or, for the maximum of the value_type, at the end. The
+      // latter steps back to the last non-empty segment.
+      [[nodiscard]] auto find_segment(const value_type& value) const -> std::size_t
+      {
+         const std::size_t count = detail::branchless_partition_point(m_minimums.size(), [&](const std::size_t i)
+         {
+            return m_minimums[i] <= value;
+         });
+         std::size_t segment = count == 0 ? 0 : count - 1;
+         while (segment > 0 && m_counts[segment] == 0)
+         {
+            --segment;
+         }
+         return segment;
+      }
+
+
+      [[nodiscard]] auto lower_bound_in_segment(const std::size_t segment, const value_type& value) const -> std::size_t
+      {
+         const optional_type* data = m_slots.data() + segment * segment_size;
+         return detail::branchless_partition_point(m_counts[segment], [&](const std::size_t i)
+         {
+            return *data[i] < value;
+         });
+      }
+
+
+      // Recomputes the minimums of [first, last) and of the empty segments before first
+      auto update_minimums(const std::size_t first, const std::size_t last) -> void
+      {
+         value_type next = last < m_minimums.size() ? m_minimums[last] : std::numeric_limits<value_type>::max();
+         for (std::size_t segment = last; segment-- > first; )
+         {
+            m_minimums[segment] = m_counts[segment] > 0 ? *m_slots[segment * segment_size] : next;
+            next = m_minimums[segment];
+         }
+         for (std::size_t segment = first; segment-- > 0 && m_counts[segment] == 0; )
+         {
+            m_minimums[segment] = next;
+         }
+      }
+
+
+      // Finds the smallest aligned window around the full segment with room for one more value and
+      // spreads its values evenly. Grows the array if there's no such window.
+      auto rebalance_for_insert(const std::size_t segment) -> void
+      {
+         const std::size_t segment_count = m_counts.size();
+         const std::size_t height = static_cast<std::size_t>(std::countr_zero(segment_count));
+         for (std::size_t level = 1; level <= height; ++level)
+         {
+            const std::size_t window = std::size_t{ 1 } << level;
+            const std::size_t first = segment & ~(window - 1);
+            std::size_t count = 1;
+            for (std::size_t i = first; i < first + window; ++i)
+            {
+               count += m_counts[i];
+            }
+
+            // Linear from nearly full at the lowest level to root_density for the whole array. Every
+            // segment keeps at least one hole on average, so the segment of the new value has room.
+            const double density = 1.0 - (1.0 - root_density) * static_cast<double>(level) / static_cast<double>(height);
+            const double limit = std::min(density * static_cast<double>(window * segment_size), static_cast<double>(window * (segment_size - 1)));
+            if (static_cast<double>(count) <= limit)
+            {
+               this->redistribute(first, first + window);
+               return;
+            }
+         }
+         this->redistribute_all(segment_count * 2);
+      }
+
+
+      auto gather(const std::size_t first, const std::size_t last) -> void
+      {
+         m_buffer.clear();
+         for (std::size_t segment = first; segment < last; ++segment)
+         {
+            const optional_type* data = m_slots.data() + segment * segment_size;
+            for (std::size_t i = 0; i < m_counts[segment]; ++i)
+            {
+               m_buffer.push_back(*data[i]);
+            }
+         }
+      }
+
+
+      // Spreads the values in the buffer evenly over the segments [first, last)
+      auto scatter(const std::size_t first, const std::size_t last) -> void
+      {
+         const std::size_t window = last - first;
+         const std::size_t base = m_buffer.size() / window;
+         const std::size_t remainder = m_buffer.size() % window;
+         std::size_t source = 0;
+         for (std::size_t segment = first; segment < last; ++segment)
+         {
+            optional_type* data = m_slots.data() + segment * segment_size;
+            const std::size_t count = base + static_cast<std::size_t>(segment - first < remainder);
+            for (std::size_t i = 0; i < segment_size; ++i)
+            {
+               *data[i] = i < count ? m_buffer[source + i] : null_value;
+            }
+            source += count;
+            m_counts[segment] = count;
+         }
+         this->update_minimums(first, last);
+      }
+
+
+      auto redistribute(const std::size_t first, const std::size_t last) -> void
+      {
+         this->gather(first, last);
+         this->scatter(first, last);
+      }
+
+
+      auto redistribute_all(const std::size_t segment_count) -> void
+      {
+         this->gather(0, m_counts.size());
+         m_slots.assign(segment_count * segment_size, optional_type{});
+         m_counts.assign(segment_count, 0);
+         m_minimums.assign(segment_count, std::numeric_limits<value_type>::max());
+         this->scatter(0, segment_count);
+      }
+   };
+
+} // namespace io
@@ -0,0 +1,316 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "intrusive_optional_algorithms.h"
+
+
+// Hashing, grouping and joining on nullable keys stored in columns of intrusive_optionals
+namespace io
+{
+
+   // How null keys take part in grouping and joins:
+   // - drop: Null keys are ignored. They get no group and never match.
+   // - group: All null keys form one group and match each other.
+   // - distinct: Every null key is its own group and matches nothing (SQL semantics).
+   enum class null_key_policy { drop, group, distinct };
+
+
+   // Index column. Missing indices (e.g. unmatched rows of a left join) are null.
+   using optional_index = intrusive_optional<std::numeric_limits<std::size_t>::max()>;
+
+
+   namespace detail
+   {
+
+      template <typename T>
+      constexpr inline bool is_bit_hashable = (std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_pointer_v<T> || std::is_enum_v<T>)
+         && sizeof(T) <= sizeof(std::uint64_t);
+
+
+      template <typename T>
+      [[nodiscard]] auto hash_value(const T& value) -> std::uint64_t
+      {
+         if constexpr (std::is_floating_point_v<T>)
+         {
+            // +0.0 and -0.0 compare equal and need the same hash
+            const T normalized = value == T{} ? T{} : value;
+            using bits_type = std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>;
+            return mix_hash(std::bit_cast<bits_type>(normalized));
+         }
+         else if constexpr (std::is_pointer_v<T>)
+         {
+            return mix_hash(static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(value)));
+         }
+         else if constexpr (is_bit_hashable<T>)
+         {
+            return mix_hash(static_cast<std::uint64_t>(value));
+         }
+         else
+         {
+            return mix_hash(static_cast<std::uint64_t>(std::hash<T>{}(value)));
+         }
+      }
+
+   } // namespace detail
+
+
+   // Hash of null keys in hash_column(). It's only meaningful for null_key_policy::group.
+   constexpr inline std::uint64_t null_key_hash = 0x9e3779b97f4a7c15ull;
+
+
+   // Batch hashing. For scalar keys this is an unconditional mix followed by a select for nulls,
+   // which compilers vectorize.
+   template <optional_column R>
+   auto hash_column(R&& column, const std::span<std::uint64_t> hashes) -> void
+   {
+      const auto* data = std::ranges::data(column);
+      const std::size_t size = std::ranges::size(column);
+      if (hashes.size() != size)
+      {
+         throw std::length_error("The hash output must have the size of the key column.");
+      }
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         const auto& key = detail::raw(data[i]);
+         const std::uint64_t hash = detail::hash_value(key);
+         hashes[i] = detail::is_null(data[i]) ? null_key_hash : hash;
+      }
+   }
+
+
+   namespace detail
+   {
+
+      // Chained hash table over row indices of a key column. Buckets and links are index arrays,
+      // there are no per-entry allocations.
+      template <typename opt_type>
+      class key_index
+      {
+         static constexpr std::uint32_t end_of_chain = std::numeric_limits<std::uint32_t>::max();
+
+         const opt_type* m_keys;
+         std::vector<std::uint64_t> m_hashes;
+         std::vector<std::uint32_t> m_heads;
+         std::vector<std::uint32_t> m_next;
+         std::uint64_t m_mask;
+
+      public:
+         template <typename R>
+         key_index(R&& keys, const null_key_policy policy)
+            : m_keys(std::ranges::data(keys))
+            , m_hashes(std::ranges::size(keys))
+            , m_heads(std::bit_ceil(std::max<std::size_t>(std::ranges::size(keys) * 2, 16)), end_of_chain)
+            , m_next(std::ranges::size(keys), end_of_chain)
+            , m_mask(m_heads.size() - 1)
+         {
+            if (std::ranges::size(keys) >= end_of_chain)
+            {
+               throw std::length_error("Key columns are limited to 2^32-1 rows.");
+            }
+            hash_column(keys, m_hashes);
+
+            // Insert in reverse so that chains are in row order
+            for (std::size_t i = m_hashes.size(); i-- > 0; )
+            {
+               if (detail::is_null(m_keys[i]) && policy != null_key_policy::group)
+               {
+                  continue;
+               }
+               const std::size_t bucket = m_hashes[i] & m_mask;
+               m_next[i] = m_heads[bucket];
+               m_heads[bucket] = static_cast<std::uint32_t>(i);
+            }
+         }
+
+         // Calls fn(row) for every row whose key equals the given one
+         template <typename key_type, typename fn_type>
+         auto for_each_match(const key_type& key, const bool key_is_null, const std::uint64_t hash, fn_type&& fn) const -> void
+         {
+            for (std::uint32_t row = m_heads[hash & m_mask]; row != end_of_chain; row = m_next[row])
+            {
+               if (m_hashes[row] == hash && this->matches(row, key, key_is_null))
+               {
+                  fn(static_cast<std::size_t>(row));
+               }
+            }
+         }
+
+         // First row with the same key as the given row. Chains are in row order, so that's the
+         // first match in the chain.
+         [[nodiscard]] auto find_first(const std::size_t row) const -> std::size_t
+         {
+            const std::uint64_t hash = m_hashes[row];
+            const bool row_is_null = detail::is_null(m_keys[row]);
+            for (std::uint32_t candidate = m_heads[hash & m_mask]; candidate != end_of_chain; candidate = m_next[candidate])
+            {
+               if (m_hashes[candidate] == hash && this->matches(candidate, detail::raw(m_keys[row]), row_is_null))
+               {
+                  return candidate;
+               }
+            }
+            return row;
+         }
+
+      private:
+         // Null keys match only null keys, whatever the sentinels of the two columns are. Their raw
+         // values aren't compared, a NaN sentinel isn't even equal to itself.
+         template <typename key_type>
+         [[nodiscard]] auto matches(const std::size_t row, const key_type& key, const bool key_is_null) const -> bool
+         {
+            const bool row_is_null = detail::is_null(m_keys[row]);
+            return row_is_null == key_is_null && (row_is_null || detail::raw(m_keys[row]) == key);
+         }
+      };
+
+   } // namespace detail
+
+
+
+   struct group_result
+   {
+      // Group id per row. Rows without group (null keys with null_key_policy::drop) are null.
+      std::vector<intrusive_optional<std::numeric_limits<std::uint32_t>::max()>> group_ids;
+      std::size_t group_count = 0;
+   };
+
+
+   // Dense group ids in order of first appearance
+   template <optional_column R>
+   auto group_by(R&& keys, const null_key_policy policy) -> group_result
+   {
+      using opt_type = column_optional_t<R>;
+      const auto* data = std::ranges::data(keys);
+      const std::size_t size = std::ranges::size(keys);
+      const detail::key_index<opt_type> index(keys, policy);
+
+      group_result result;
+      result.group_ids.resize(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         if (detail::is_null(data[i]) && policy != null_key_policy::group)
+         {
+            if (policy == null_key_policy::distinct)
+            {
+               result.group_ids[i].emplace(static_cast<std::uint32_t>(result.group_count++));
+            }
+            continue;
+         }
+
+         const std::size_t first = index.find_first(i);
+         if (first == i)
+         {
+            result.group_ids[i].emplace(static_cast<std::uint32_t>(result.group_count++));
+         }
+         else
+         {
+            result.group_ids[i].emplace(*result.group_ids[first]);
+         }
+      }
+      return result;
+   }
+
+
+
+   struct join_result
+   {
+      std::vector<std::size_t> left_rows;
+
+      // Null for left rows without a match in a left join
+      std::vector<optional_index> right_rows;
+   };
+
+
+   namespace detail
+   {
+
+      template <bool is_left_join, optional_column L, optional_column R>
+      auto hash_join(L&& left, R&& right, const null_key_policy policy) -> join_result
+      {
+         using left_type = column_optional_t<L>;
+         using right_type = column_optional_t<R>;
+         static_assert(std::is_same_v<typename left_type::value_type, typename right_type::value_type>,
+            "Join keys must have the same value_type.");
+
+         // The right side is the build side
+         const key_index<right_type> index(right, policy);
+         const auto* left_data = std::ranges::data(left);
+         const std::size_t left_size = std::ranges::size(left);
+         std::vector<std::uint64_t> left_hashes(left_size);
+         hash_column(left, left_hashes);
+
+         join_result result;
+         result.left_rows.reserve(left_size);
+         result.right_rows.reserve(left_size);
+         for (std::size_t i = 0; i < left_size; ++i)
+         {
+            bool matched = false;
+            if (detail::is_null(left_data[i]) == false || policy == null_key_policy::group)
+            {
+               index.for_each_match(detail::raw(left_data[i]), detail::is_null(left_data[i]), left_hashes[i], [&](const std::size_t right_row)
+               {
+                  result.left_rows.push_back(i);
+                  result.right_rows.emplace_back(right_row);
+                  matched = true;
+               });
+            }
+            if constexpr (is_left_join)
+            {
+               const bool keep_unmatched = detail::is_null(left_data[i]) == false || policy != null_key_policy::drop;
+               if (matched == false && keep_unmatched)
+               {
+                  result.left_rows.push_back(i);
+                  result.right_rows.emplace_back();
+               }
+            }
+         }
+         return result;
+      }
+
+   } // namespace detail
+
+
+   template <optional_column L, optional_column R>
+   auto inner_join(L&& left, R&& right, const null_key_policy policy = null_key_policy::distinct) -> join_result
+   {
+      return detail::hash_join<false>(left, right, policy);
+   }
+
+
+   // Every left row appears at least once. With null_key_policy::drop, left rows with null keys
+   // are removed from the result.
+   template <optional_column L, optional_column R>
+   auto left_join(L&& left, R&& right, const null_key_policy policy = null_key_policy::distinct) -> join_result
+   {
+      return detail::hash_join<true>(left, right, policy);
+   }
+
+
+   // Materializes a column for the rows of a join result. Null indices produce the sentinel, so an
+   // output column of a left join marks missing matches without a separate validity bitmap. Null
+   // source rows produce the sentinel of the output as well, which may differ from the source.
+   template <optional_column R, mutable_optional_column O>
+   auto gather(R&& column, const std::span<const optional_index> rows, O&& output) -> void
+   {
+      using opt_type = column_optional_t<O>;
+      const auto* data = std::ranges::data(column);
+      auto* out = std::ranges::data(output);
+      if (std::ranges::size(output) != rows.size())
+      {
+         throw std::length_error("The gather output must have the size of the row column.");
+      }
+      for (std::size_t i = 0; i < rows.size(); ++i)
+      {
+         const bool engaged = rows[i].has_value() && detail::is_null(data[*rows[i]]) == false;
+         detail::raw(out[i]) = engaged ? detail::raw(data[*rows[i]]) : opt_type::null_value;
+      }
+   }
+
+} // namespace io
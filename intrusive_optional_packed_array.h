@@ -0,0 +1,358 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "intrusive_optional.h"
+
+
+namespace io
+{
+
+   // Array of optionals with a small domain, each stored in code_bits bits. The code null_code is
+   // the sentinel, by default the all-ones code. Codes never straddle words: A 64-bit word holds
+   // 64 / code_bits of them and the remaining bits are unused. That keeps the element access a single
+   // shift and mask, and the loops over words vectorize. Failures go to failure_policy: value() on a
+   // null element with optional_errc::bad_access, values outside the code bits and ranges past the
+   // end with optional_errc::capacity_exceeded.
+   template <unsigned code_bits, std::uint64_t null_code = (std::uint64_t{ 1 } << code_bits) - 1,
+      typename failure_policy = throw_on_failure>
+   requires (code_bits > 0 && code_bits <= 16 && null_code < (std::uint64_t{ 1 } << code_bits))
+   class packed_optional_array
+   {
+   public:
+      using value_type = std::conditional_t<code_bits <= 8, std::uint8_t, std::uint16_t>;
+      using optional_type = intrusive_optional<static_cast<value_type>(null_code)>;
+
+      static constexpr std::size_t codes_per_word = 64 / code_bits;
+      static constexpr std::uint64_t code_mask = (std::uint64_t{ 1 } << code_bits) - 1;
+
+   private:
+      std::vector<std::uint64_t> m_words;
+      std::size_t m_size = 0;
+
+      // null_code in every code of a word
+      static constexpr auto broadcast(const std::uint64_t code) -> std::uint64_t
+      {
+         std::uint64_t result = 0;
+         for (std::size_t i = 0; i < codes_per_word; ++i)
+         {
+            result |= code << (i * code_bits);
+         }
+         return result;
+      }
+      static constexpr std::uint64_t null_word = broadcast(null_code);
+
+      static constexpr auto word_count(const std::size_t size) -> std::size_t
+      {
+         return (size + codes_per_word - 1) / codes_per_word;
+      }
+
+      static constexpr auto shift_of(const std::size_t index) -> unsigned
+      {
+         return static_cast<unsigned>(index % codes_per_word * code_bits);
+      }
+
+      static auto ensure_in_domain(const std::uint64_t code) -> void
+      {
+         if (code > code_mask)
+         {
+            failure_policy::fail(optional_errc::capacity_exceeded);
+         }
+      }
+
+
+      // Proxy for one element with the interface of intrusive_optional
+      template <typename word_type>
+      class basic_reference
+      {
+         word_type* m_word;
+         unsigned m_shift;
+
+         friend class packed_optional_array;
+
+         basic_reference(word_type* word, const unsigned shift) noexcept
+            : m_word(word)
+            , m_shift(shift)
+         { }
+
+         [[nodiscard]] auto code() const noexcept -> value_type
+         {
+            return static_cast<value_type>(*m_word >> m_shift & code_mask);
+         }
+
+         auto write(const std::uint64_t code) const noexcept -> void
+         {
+            *m_word = (*m_word & ~(code_mask << m_shift)) | (code << m_shift);
+         }
+
+      public:
+         [[nodiscard]] auto has_value() const noexcept -> bool
+         {
+            return this->code() != null_code;
+         }
+
+         explicit operator bool() const noexcept
+         {
+            return this->has_value();
+         }
+
+         // A copy since the element isn't addressable
+         auto operator*() const noexcept -> value_type
+         {
+            return this->code();
+         }
+
+         auto value() const -> value_type
+         {
+            if (this->has_value() == false)
+            {
+               failure_policy::fail(optional_errc::bad_access);
+            }
+            return this->code();
+         }
+
+         auto value_or(const value_type default_value) const noexcept -> value_type
+         {
+            return this->has_value() ? this->code() : default_value;
+         }
+
+         operator optional_type() const noexcept
+         {
+            return optional_type(this->code());
+         }
+
+         [[nodiscard]] auto get_std() const -> std::optional<value_type>
+         {
+            if (this->has_value() == false)
+            {
+               return std::nullopt;
+            }
+            return this->code();
+         }
+
+         // Proxies assign through, like std::vector<bool>::reference. Writing the null_code makes the
+         // element null.
+         auto operator=(const value_type value) const -> const basic_reference&
+            requires (std::is_const_v<word_type> == false)
+         {
+            ensure_in_domain(value);
+            this->write(value);
+            return *this;
+         }
+
+         auto operator=(const optional_type& opt) const -> const basic_reference&
+            requires (std::is_const_v<word_type> == false)
+         {
+            ensure_in_domain(*opt);
+            this->write(*opt);
+            return *this;
+         }
+
+         auto operator=(std::nullopt_t) const noexcept -> const basic_reference&
+            requires (std::is_const_v<word_type> == false)
+         {
+            this->reset();
+            return *this;
+         }
+
+         auto operator=(const basic_reference& other) const noexcept -> const basic_reference&
+            requires (std::is_const_v<word_type> == false)
+         {
+            this->write(other.code());
+            return *this;
+         }
+
+         auto reset() const noexcept -> void
+            requires (std::is_const_v<word_type> == false)
+         {
+            this->write(null_code);
+         }
+
+         friend auto operator==(const basic_reference& ref, std::nullopt_t) noexcept -> bool
+         {
+            return ref.has_value() == false;
+         }
+
+         friend auto operator==(const basic_reference& ref, const value_type value) noexcept -> bool
+         {
+            return ref.has_value() && ref.code() == value;
+         }
+      };
+
+   public:
+      using reference = basic_reference<std::uint64_t>;
+      using const_reference = basic_reference<const std::uint64_t>;
+
+      packed_optional_array() = default;
+
+      // All null
+      explicit packed_optional_array(const std::size_t size)
+         : m_words(word_count(size), null_word)
+         , m_size(size)
+      { }
+
+      [[nodiscard]] auto size() const noexcept -> std::size_t
+      {
+         return m_size;
+      }
+
+      [[nodiscard]] auto empty() const noexcept -> bool
+      {
+         return m_size == 0;
+      }
+
+      [[nodiscard]] auto size_in_bytes() const noexcept -> std::size_t
+      {
+         return m_words.size() * sizeof(std::uint64_t);
+      }
+
+      [[nodiscard]] auto words() const noexcept -> std::span<const std::uint64_t>
+      {
+         return m_words;
+      }
+
+      // New elements are null
+      auto resize(const std::size_t size) -> void
+      {
+         m_words.resize(word_count(size), null_word);
+         if (size < m_size && size % codes_per_word != 0)
+         {
+            const std::uint64_t kept = (std::uint64_t{ 1 } << shift_of(size)) - 1;
+            m_words.back() = (m_words.back() & kept) | (null_word & ~kept);
+         }
+         m_size = size;
+      }
+
+      // Validates before growing, so a value outside the domain leaves the size unchanged
+      auto push_back(const optional_type& opt) -> void
+      {
+         ensure_in_domain(*opt);
+         this->resize(m_size + 1);
+         (*this)[m_size - 1] = opt;
+      }
+
+      auto operator[](const std::size_t index) noexcept -> reference
+      {
+         return reference(m_words.data() + index / codes_per_word, shift_of(index));
+      }
+
+      auto operator[](const std::size_t index) const noexcept -> const_reference
+      {
+         return const_reference(m_words.data() + index / codes_per_word, shift_of(index));
+      }
+
+
+
+      // Writes the elements [first, first + output.size()) into a column. Null codes become the
+      // sentinel of optional_type without a branch.
+      auto unpack(const std::size_t first, const std::span<optional_type> output) const -> void
+      {
+         if (first + output.size() > m_size)
+         {
+            failure_policy::fail(optional_errc::capacity_exceeded);
+         }
+         std::size_t index = first;
+         std::size_t out = 0;
+
+         // Up to the next word boundary, then whole words with a fixed inner loop
+         for (; index % codes_per_word != 0 && out < output.size(); ++index, ++out)
+         {
+            *output[out] = *(*this)[index];
+         }
+         const std::uint64_t* word = m_words.data() + index / codes_per_word;
+         for (; out + codes_per_word <= output.size(); out += codes_per_word, index += codes_per_word, ++word)
+         {
+            const std::uint64_t bits = *word;
+            for (std::size_t i = 0; i < codes_per_word; ++i)
+            {
+               *output[out + i] = static_cast<value_type>(bits >> (i * code_bits) & code_mask);
+            }
+         }
+         for (; out < output.size(); ++index, ++out)
+         {
+            *output[out] = *(*this)[index];
+         }
+      }
+
+
+      // Overwrites the elements [first, first + input.size()) with a column. Fails before writing
+      // anything if a value doesn't fit into the code bits.
+      auto pack(const std::size_t first, const std::span<const optional_type> input) -> void
+      {
+         if (first + input.size() > m_size)
+         {
+            failure_policy::fail(optional_errc::capacity_exceeded);
+         }
+         if constexpr (std::numeric_limits<value_type>::digits > code_bits)
+         {
+            value_type combined = 0;
+            for (const optional_type& opt : input)
+            {
+               combined |= *opt;
+            }
+            ensure_in_domain(combined);
+         }
+
+         std::size_t index = first;
+         std::size_t in = 0;
+         for (; index % codes_per_word != 0 && in < input.size(); ++index, ++in)
+         {
+            (*this)[index].write(*input[in]);
+         }
+         std::uint64_t* word = m_words.data() + index / codes_per_word;
+         for (; in + codes_per_word <= input.size(); in += codes_per_word, index += codes_per_word, ++word)
+         {
+            std::uint64_t bits = 0;
+            for (std::size_t i = 0; i < codes_per_word; ++i)
+            {
+               bits |= static_cast<std::uint64_t>(*input[in + i]) << (i * code_bits);
+            }
+            *word = bits;
+         }
+         for (; in < input.size(); ++index, ++in)
+         {
+            (*this)[index].write(*input[in]);
+         }
+      }
+
+
+      // Counts the null codes a word at a time: After xor with the broadcast null_code, null codes are
+      // zero. Adding the low bits of every code sets its top bit unless they're all zero, so a code is
+      // zero exactly if neither that sum nor the code itself has the top bit set. The sums can't carry
+      // into the next code.
+      [[nodiscard]] auto count_null() const noexcept -> std::size_t
+      {
+         constexpr std::uint64_t high_bits = broadcast(std::uint64_t{ 1 } << (code_bits - 1));
+         constexpr std::uint64_t low_bits = broadcast((std::uint64_t{ 1 } << (code_bits - 1)) - 1);
+
+         const auto count_in_word = [&](const std::uint64_t word, const std::uint64_t valid_high_bits)
+         {
+            const std::uint64_t difference = word ^ null_word;
+            const std::uint64_t nonzero = ((difference & low_bits) + low_bits) | difference;
+            return static_cast<std::size_t>(std::popcount(~nonzero & valid_high_bits));
+         };
+
+         const std::size_t full_words = m_size / codes_per_word;
+         std::size_t count = 0;
+         for (std::size_t i = 0; i < full_words; ++i)
+         {
+            count += count_in_word(m_words[i], high_bits);
+         }
+         if (const std::size_t rest = m_size % codes_per_word; rest != 0)
+         {
+            const std::uint64_t valid = high_bits & ((std::uint64_t{ 1 } << (rest * code_bits)) - 1);
+            count += count_in_word(m_words[full_words], valid);
+         }
+         return count;
+      }
+   };
+
+} // namespace io
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "intrusive_optional.h"
+
+
+namespace io
+{
+
+   namespace detail
+   {
+
+      template <typename T, std::size_t offset>
+      consteval auto value_initialized_byte() -> unsigned char
+      {
+         return std::bit_cast<std::array<unsigned char, sizeof(T)>>(T{})[offset];
+      }
+
+      // Whether the byte at the offset is padding of T. Padding bytes of a bit_cast are indeterminate,
+      // so reading them isn't a constant expression, while member bytes are.
+      template <typename T, std::size_t offset>
+      concept padding_byte = offset < sizeof(T)
+         && requires { typename std::bool_constant<(std::bit_cast<std::array<unsigned char, sizeof(T)>>(T{}), true)>; }
+         && requires { typename std::integral_constant<unsigned char, value_initialized_byte<T, offset>()>; } == false;
+
+   } // namespace detail
+
+
+   // Optional that keeps the engaged flag in a padding byte of T, for types that have no spare
+   // value but padding, like { std::int32_t; char; }. The padding offset is declared by the user,
+   // typically as the end of the member before the padding, and checked at compile time:
+   // io::padding_optional<my_type, offsetof(my_type, c) + sizeof(char)>
+   //
+   // Writes to a T may clobber its padding, so there's no mutable access to the value. It's changed
+   // through emplace() or assignment, which set the flag again afterwards. Copies copy the raw bytes
+   // including the flag. value() on a null optional goes to failure_policy.
+   template <typename T, std::size_t padding_offset, typename failure_policy = throw_on_failure>
+   class padding_optional
+   {
+      static_assert(std::is_trivially_copyable_v<T>, "padding_optional requires a trivially copyable type.");
+      static_assert(std::is_standard_layout_v<T>, "padding_optional requires a standard-layout type, so that offsetof works.");
+      static_assert(padding_offset < sizeof(T), "The padding offset must be inside the type.");
+      static_assert(detail::padding_byte<T, padding_offset>,
+         "The byte at padding_offset must be padding of T, and T{} must be a constant expression.");
+
+      static constexpr unsigned char engaged_flag = 1;
+
+      alignas(T) unsigned char m_storage[sizeof(T)];
+
+      auto flag() const noexcept -> unsigned char
+      {
+         return m_storage[padding_offset];
+      }
+
+   public:
+      using value_type = T;
+
+      padding_optional() noexcept
+      {
+         m_storage[padding_offset] = 0;
+      }
+
+      padding_optional(std::nullopt_t) noexcept
+         : padding_optional()
+      { }
+
+      padding_optional(const T& value) noexcept
+      {
+         this->emplace(value);
+      }
+
+      template <typename ... Args>
+      requires std::is_constructible_v<T, Args...>
+      explicit padding_optional(std::in_place_t, Args&&... args)
+      {
+         this->emplace(std::forward<Args>(args)...);
+      }
+
+      auto operator=(const T& value) noexcept -> padding_optional&
+      {
+         this->emplace(value);
+         return *this;
+      }
+
+      auto operator=(std::nullopt_t) noexcept -> padding_optional&
+      {
+         this->reset();
+         return *this;
+      }
+
+
+      [[nodiscard]] auto has_value() const noexcept -> bool
+      {
+         return this->flag() == engaged_flag;
+      }
+
+      explicit operator bool() const noexcept
+      {
+         return this->has_value();
+      }
+
+      auto operator*() const noexcept -> const T&
+      {
+         return *std::launder(reinterpret_cast<const T*>(m_storage));
+      }
+
+      auto operator->() const noexcept -> const T*
+      {
+         return std::launder(reinterpret_cast<const T*>(m_storage));
+      }
+
+      auto value() const -> const T&
+      {
+         if (this->has_value() == false)
+         {
+            failure_policy::fail(optional_errc::bad_access);
+         }
+         return **this;
+      }
+
+      template <typename U>
+      requires std::is_convertible_v<U&&, T>
+      auto value_or(U&& default_value) const -> T
+      {
+         return this->has_value() ? **this : static_cast<T>(std::forward<U>(default_value));
+      }
+
+      [[nodiscard]] auto get_std() const -> std::optional<T>
+      {
+         if (this->has_value() == false)
+         {
+            return std::nullopt;
+         }
+         return **this;
+      }
+
+
+      template <typename ... Args>
+      requires std::is_constructible_v<T, Args...>
+      auto emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args...>) -> const T&
+      {
+         const T* value = std::construct_at(reinterpret_cast<T*>(m_storage), std::forward<Args>(args)...);
+         m_storage[padding_offset] = engaged_flag;
+         return *value;
+      }
+
+      auto reset() noexcept -> void
+      {
+         m_storage[padding_offset] = 0;
+      }
+
+      auto swap(padding_optional& other) noexcept -> void
+      {
+         std::swap(m_storage, other.m_storage);
+      }
+
+
+      friend auto operator==(const padding_optional& lhs, const padding_optional& rhs) -> bool
+         requires requires(const T& value) { bool(value == value); }
+      {
+         if (lhs.has_value() != rhs.has_value())
+            return false;
+         if (lhs.has_value() == false)
+            return true;
+         return *lhs == *rhs;
+      }
+
+      friend auto operator==(const padding_optional& opt, std::nullopt_t) noexcept -> bool
+      {
+         return opt.has_value() == false;
+      }
+   };
+
+
+   template <typename T, std::size_t padding_offset, typename failure_policy>
+   struct is_trivially_relocatable<padding_optional<T, padding_offset, failure_policy>> : std::true_type {};
+
+} // namespace io
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "intrusive_optional_views.h"
+
+
+namespace io
+{
+
+   // Handle into a slot_map: The slot index in the lower and its generation in the upper 32 bits.
+   // Default-constructed handles are never valid.
+   struct slot_handle
+   {
+      std::uint64_t bits = 0;
+
+      constexpr slot_handle() = default;
+
+      constexpr slot_handle(const std::uint32_t index, const std::uint32_t generation)
+         : bits((static_cast<std::uint64_t>(generation) << 32) | index)
+      { }
+
+      [[nodiscard]] constexpr auto index() const -> std::uint32_t
+      {
+         return static_cast<std::uint32_t>(bits);
+      }
+
+      [[nodiscard]] constexpr auto generation() const -> std::uint32_t
+      {
+         return static_cast<std::uint32_t>(bits >> 32);
+      }
+
+      constexpr auto operator==(const slot_handle&) const -> bool = default;
+   };
+
+
+   // Slot map with stable handles. The slots are intrusive_optionals and free slots are null, so
+   // there's no occupancy bitmap: Iteration skips free slots by scanning for the sentinel (see
+   // io::views::engaged). Erased slots are reused in LIFO order and their generation is increased,
+   // which invalidates the old handles. Failures go to failure_policy.
+   template <auto null_value, typename failure_policy = throw_on_failure>
+   class slot_map
+   {
+   public:
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+      using handle = slot_handle;
+
+   private:
+      std::vector<optional_type> m_slots;
+      std::vector<std::uint32_t> m_generations;
+      std::vector<std::uint32_t> m_free_slots;
+
+   public:
+      slot_map() = default;
+
+      // Inserting the null_value fails with optional_errc::unintentionally_null since it would make
+      // the slot free. More than 2^32-1 slots fail with optional_errc::capacity_exceeded.
+      template <typename ... Args>
+      auto emplace(Args&&... args) -> handle
+      {
+         if (m_free_slots.empty())
+         {
+            if (m_slots.size() == std::numeric_limits<std::uint32_t>::max())
+            {
+               failure_policy::fail(optional_errc::capacity_exceeded);
+            }
+            const optional_type value(std::in_place, std::forward<Args>(args)...);
+            if (value.has_value() == false)
+            {
+               failure_policy::fail(optional_errc::unintentionally_null);
+            }
+            m_slots.push_back(value);
+            m_generations.push_back(1);
+            return handle(static_cast<std::uint32_t>(m_slots.size() - 1), 1);
+         }
+
+         const std::uint32_t index = m_free_slots.back();
+         m_slots[index].emplace(std::forward<Args>(args)...);
+         if (m_slots[index].has_value() == false)
+         {
+            failure_policy::fail(optional_errc::unintentionally_null);
+         }
+         m_free_slots.pop_back();
+         return handle(index, m_generations[index]);
+      }
+
+      auto insert(const value_type& value) -> handle
+      {
+         return this->emplace(value);
+      }
+
+      // Returns false for stale handles
+      auto erase(const handle h) -> bool
+      {
+         if (this->contains(h) == false)
+         {
+            return false;
+         }
+         const std::uint32_t index = h.index();
+         m_slots[index].reset();
+         ++m_generations[index];
+         m_free_slots.push_back(index);
+         return true;
+      }
+
+      [[nodiscard]] auto contains(const handle h) const -> bool
+      {
+         const std::uint32_t index = h.index();
+         return index < m_slots.size() && m_generations[index] == h.generation() && m_slots[index].has_value();
+      }
+
+      // nullptr for stale handles
+      [[nodiscard]] auto find(const handle h) -> value_type*
+      {
+         return this->contains(h) ? m_slots[h.index()].operator->() : nullptr;
+      }
+
+      [[nodiscard]] auto find(const handle h) const -> const value_type*
+      {
+         return this->contains(h) ? m_slots[h.index()].operator->() : nullptr;
+      }
+
+      [[nodiscard]] auto size() const -> std::size_t
+      {
+         return m_slots.size() - m_free_slots.size();
+      }
+
+      [[nodiscard]] auto empty() const -> bool
+      {
+         return this->size() == 0;
+      }
+
+      // Erases everything. Outstanding handles stay invalid.
+      auto clear() -> void
+      {
+         m_free_slots.clear();
+         for (std::size_t i = m_slots.size(); i-- > 0; )
+         {
+            if (m_slots[i].has_value())
+            {
+               ++m_generations[i];
+            }
+            m_slots[i].reset();
+            m_free_slots.push_back(static_cast<std::uint32_t>(i));
+         }
+      }
+
+      // The values in slot order
+      [[nodiscard]] auto values() -> auto
+      {
+         return m_slots | views::engaged;
+      }
+
+      [[nodiscard]] auto values() const -> auto
+      {
+         return m_slots | views::engaged;
+      }
+
+      // Calls fn(handle, value) for every value in slot order
+      template <typename fn_type>
+      auto for_each(fn_type&& fn) -> void
+      {
+         for (const std::size_t index : m_slots | views::indices_engaged)
+         {
+            fn(handle(static_cast<std::uint32_t>(index), m_generations[index]), *m_slots[index]);
+         }
+      }
+
+      template <typename fn_type>
+      auto for_each(fn_type&& fn) const -> void
+      {
+         for (const std::size_t index : m_slots | views::indices_engaged)
+         {
+            fn(handle(static_cast<std::uint32_t>(index), m_generations[index]), *m_slots[index]);
+         }
+      }
+   };
+
+} // namespace io
@@ -0,0 +1,189 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "intrusive_optional_algorithms.h"
+
+
+// Lookup tables with a perfect hash, built at compile time
+namespace io
+{
+
+   namespace detail
+   {
+
+      [[nodiscard]] constexpr auto static_key_hash(const std::string_view key) -> std::uint64_t
+      {
+         // FNV-1a
+         std::uint64_t hash = 0xcbf29ce484222325ull;
+         for (const char c : key)
+         {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 0x100000001b3ull;
+         }
+         return mix_hash(hash);
+      }
+
+      template <typename T>
+      requires (std::is_integral_v<T> || std::is_enum_v<T>)
+      [[nodiscard]] constexpr auto static_key_hash(const T key) -> std::uint64_t
+      {
+         return mix_hash(static_cast<std::uint64_t>(key));
+      }
+
+
+      // Slot of a key hash with the displacement seed of its bucket
+      [[nodiscard]] constexpr auto displaced_slot(const std::uint64_t hash, const std::uint32_t seed, const std::size_t capacity) -> std::size_t
+      {
+         return static_cast<std::size_t>(mix_hash(hash ^ (static_cast<std::uint64_t>(seed) * 0x9e3779b97f4a7c15ull))) & (capacity - 1);
+      }
+
+   } // namespace detail
+
+
+   // Immutable map from keys to values with a perfect hash (hash and displace): The key hash selects
+   // a bucket, the bucket's seed displaces the hash into a slot that no other key uses. A lookup
+   // hashes the key once and compares with a single slot. Empty slots are null, so the table is
+   // just the keys, the values and one seed per bucket. Build it with make_static_map().
+   template <typename key_type, auto null_value, std::size_t entry_count>
+   class static_map;
+
+   template <auto null_value, typename key_type, std::size_t entry_count>
+   constexpr auto make_static_map(const std::pair<key_type, typename intrusive_optional<null_value>::value_type>(&entries)[entry_count])
+      -> static_map<key_type, null_value, entry_count>;
+
+
+   template <typename key_type, auto null_value, std::size_t entry_count>
+   class static_map
+   {
+   public:
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+
+      // At most 3/4 full, a power of two
+      static constexpr std::size_t capacity = std::bit_ceil(std::max<std::size_t>(entry_count + entry_count / 3, 1));
+      static constexpr std::size_t bucket_count = std::max<std::size_t>(entry_count / 4, 1);
+
+   private:
+      std::array<key_type, capacity> m_keys{};
+      std::array<optional_type, capacity> m_values{};
+      std::array<std::uint32_t, bucket_count> m_seeds{};
+
+      template <auto null_value_0, typename key_type_0, std::size_t entry_count_0>
+      friend constexpr auto make_static_map(const std::pair<key_type_0, typename intrusive_optional<null_value_0>::value_type>(&entries)[entry_count_0])
+         -> static_map<key_type_0, null_value_0, entry_count_0>;
+
+   public:
+      // Null if the key isn't in the map
+      [[nodiscard]] constexpr auto find(const key_type& key) const -> optional_type
+      {
+         const std::uint64_t hash = detail::static_key_hash(key);
+         const std::size_t slot = detail::displaced_slot(hash, m_seeds[hash % bucket_count], capacity);
+         return m_keys[slot] == key ? m_values[slot] : optional_type{};
+      }
+
+      [[nodiscard]] constexpr auto contains(const key_type& key) const -> bool
+      {
+         return this->find(key).has_value();
+      }
+
+      [[nodiscard]] static constexpr auto size() -> std::size_t
+      {
+         return entry_count;
+      }
+   };
+
+
+   // Builds a static_map. Meant for constexpr variables, where duplicate keys or values equal to the
+   // null_value are compile errors:
+   // constexpr auto opcodes = io::make_static_map<-1, std::string_view>({ {"add", 1}, {"sub", 2} });
+   template <auto null_value, typename key_type, std::size_t entry_count>
+   constexpr auto make_static_map(const std::pair<key_type, typename intrusive_optional<null_value>::value_type>(&entries)[entry_count])
+      -> static_map<key_type, null_value, entry_count>
+   {
+      using map_type = static_map<key_type, null_value, entry_count>;
+      constexpr std::size_t capacity = map_type::capacity;
+      constexpr std::size_t bucket_count = map_type::bucket_count;
+      map_type result;
+
+      std::array<std::uint64_t, entry_count> hashes{};
+      std::array<std::size_t, entry_count> order{};
+      std::array<std::size_t, bucket_count> bucket_sizes{};
+      for (std::size_t i = 0; i < entry_count; ++i)
+      {
+         for (std::size_t j = 0; j < i; ++j)
+         {
+            if (entries[j].first == entries[i].first)
+            {
+               throw std::invalid_argument("Duplicate key in make_static_map().");
+            }
+         }
+         if (detail::is_null_value<null_value>(entries[i].second))
+         {
+            throw unintentionally_null{};
+         }
+         hashes[i] = detail::static_key_hash(entries[i].first);
+         ++bucket_sizes[hashes[i] % bucket_count];
+         order[i] = i;
+      }
+
+      // Largest buckets first, while the table is still empty. Entries of a bucket are adjacent.
+      std::sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b)
+      {
+         const std::size_t bucket_a = hashes[a] % bucket_count;
+         const std::size_t bucket_b = hashes[b] % bucket_count;
+         if (bucket_sizes[bucket_a] != bucket_sizes[bucket_b])
+            return bucket_sizes[bucket_a] > bucket_sizes[bucket_b];
+         return bucket_a < bucket_b;
+      });
+
+      std::array<bool, capacity> used{};
+      for (std::size_t begin = 0; begin < entry_count; )
+      {
+         const std::size_t bucket = hashes[order[begin]] % bucket_count;
+         const std::size_t end = begin + bucket_sizes[bucket];
+         std::uint32_t seed = 0;
+         for (;; ++seed)
+         {
+            if (seed == (1u << 20))
+            {
+               throw std::logic_error("make_static_map() found no perfect hash.");
+            }
+            bool fits = true;
+            for (std::size_t i = begin; i < end && fits; ++i)
+            {
+               const std::size_t slot = detail::displaced_slot(hashes[order[i]], seed, capacity);
+               fits = used[slot] == false;
+               for (std::size_t j = begin; j < i && fits; ++j)
+               {
+                  fits = detail::displaced_slot(hashes[order[j]], seed, capacity) != slot;
+               }
+            }
+            if (fits)
+            {
+               break;
+            }
+         }
+
+         result.m_seeds[bucket] = seed;
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            const std::size_t slot = detail::displaced_slot(hashes[order[i]], seed, capacity);
+            used[slot] = true;
+            result.m_keys[slot] = entries[order[i]].first;
+            result.m_values[slot] = entries[order[i]].second;
+         }
+         begin = end;
+      }
+      return result;
+   }
+
+} // namespace io
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+
+#include "intrusive_optional.h"
+
+
+namespace io
+{
+
+   // Optional pointer with tag_bits user flags in the low bits that the alignment of T leaves zero.
+   // Null is the nullptr with any tag, so has_value() ignores the flags. It's a single word, so it can
+   // be updated atomically with atomic_tagged_optional_ptr. value() on a null pointer goes to
+   // failure_policy.
+   template <typename T, unsigned tag_bits, typename failure_policy = throw_on_failure>
+   requires (tag_bits > 0)
+   class tagged_optional_ptr
+   {
+   public:
+      using value_type = T*;
+      using tag_type = std::uintptr_t;
+
+      static constexpr tag_type tag_mask = (tag_type{ 1 } << tag_bits) - 1;
+      static constexpr std::uintptr_t pointer_mask = ~tag_mask;
+
+      // Mask of a single flag. Bits outside the tag give an empty mask, like set_tag() masks the tag,
+      // so they never reach the pointer.
+      [[nodiscard]] static constexpr auto flag_mask(const unsigned bit) noexcept -> std::uintptr_t
+      {
+         return bit < tag_bits ? std::uintptr_t{ 1 } << bit : 0;
+      }
+
+   private:
+      std::uintptr_t m_word = 0;
+
+      // Checked where pointers are stored rather than in the class, where T may still be incomplete
+      // for self-referential nodes
+      static constexpr auto check_alignment() noexcept -> void
+      {
+         static_assert(tag_bits <= static_cast<unsigned>(std::countr_zero(alignof(T))),
+            "T isn't aligned enough for that many tag bits.");
+      }
+
+   public:
+      constexpr tagged_optional_ptr() noexcept = default;
+
+      constexpr tagged_optional_ptr(std::nullopt_t) noexcept
+      { }
+
+      tagged_optional_ptr(T* pointer, const tag_type tag = 0) noexcept
+         : m_word(reinterpret_cast<std::uintptr_t>(pointer) | (tag & tag_mask))
+      {
+         check_alignment();
+      }
+
+      [[nodiscard]] static constexpr auto from_word(const std::uintptr_t word) noexcept -> tagged_optional_ptr
+      {
+         tagged_optional_ptr result;
+         result.m_word = word;
+         return result;
+      }
+
+      [[nodiscard]] constexpr auto word() const noexcept -> std::uintptr_t
+      {
+         return m_word;
+      }
+
+
+
+      // Observers
+      [[nodiscard]] constexpr auto has_value() const noexcept -> bool
+      {
+         return (m_word & pointer_mask) != 0;
+      }
+
+      explicit constexpr operator bool() const noexcept
+      {
+         return this->has_value();
+      }
+
+      [[nodiscard]] auto get() const noexcept -> T*
+      {
+         return reinterpret_cast<T*>(m_word & pointer_mask);
+      }
+
+      auto operator*() const noexcept -> T&
+      {
+         return *this->get();
+      }
+
+      auto operator->() const noexcept -> T*
+      {
+         return this->get();
+      }
+
+      auto value() const -> T&
+      {
+         if (this->has_value() == false)
+         {
+            failure_policy::fail(optional_errc::bad_access);
+         }
+         return *this->get();
+      }
+
+      // The pointer without the tag
+      [[nodiscard]] auto pointer() const noexcept -> intrusive_optional<static_cast<T*>(nullptr)>
+      {
+         return this->get();
+      }
+
+
+
+      // Tag
+      [[nodiscard]] constexpr auto tag() const noexcept -> tag_type
+      {
+         return m_word & tag_mask;
+      }
+
+      constexpr auto set_tag(const tag_type tag) noexcept -> void
+      {
+         m_word = (m_word & pointer_mask) | (tag & tag_mask);
+      }
+
+      [[nodiscard]] constexpr auto flag(const unsigned bit) const noexcept -> bool
+      {
+         return (m_word & flag_mask(bit)) != 0;
+      }
+
+      constexpr auto set_flag(const unsigned bit, const bool value = true) noexcept -> void
+      {
+         const std::uintptr_t bit_mask = flag_mask(bit);
+         m_word = value ? (m_word | bit_mask) : (m_word & ~bit_mask);
+      }
+
+
+
+      // Modifiers. Both keep the tag.
+      auto set_pointer(T* pointer) noexcept -> void
+      {
+         check_alignment();
+         m_word = reinterpret_cast<std::uintptr_t>(pointer) | this->tag();
+      }
+
+      constexpr auto reset() noexcept -> void
+      {
+         m_word &= tag_mask;
+      }
+
+      constexpr auto swap(tagged_optional_ptr& other) noexcept -> void
+      {
+         std::swap(m_word, other.m_word);
+      }
+
+
+
+      // Comparisons. Pointer and tag have to be equal.
+      friend constexpr auto operator==(const tagged_optional_ptr& lhs, const tagged_optional_ptr& rhs) noexcept -> bool = default;
+
+      friend constexpr auto operator==(const tagged_optional_ptr& opt, std::nullopt_t) noexcept -> bool
+      {
+         return opt.has_value() == false;
+      }
+   };
+
+
+   // Atomic tagged_optional_ptr. Pointer and tag change together in one compare_exchange, the flags
+   // can also be changed on their own with fetch_set_flag() and fetch_clear_flag().
+   template <typename T, unsigned tag_bits, typename failure_policy = throw_on_failure>
+   class atomic_tagged_optional_ptr
+   {
+   public:
+      using value_type = tagged_optional_ptr<T, tag_bits, failure_policy>;
+
+   private:
+      std::atomic<std::uintptr_t> m_word{ 0 };
+
+   public:
+      static constexpr bool is_always_lock_free = std::atomic<std::uintptr_t>::is_always_lock_free;
+
+      atomic_tagged_optional_ptr() noexcept = default;
+
+      atomic_tagged_optional_ptr(const value_type desired) noexcept
+         : m_word(desired.word())
+      { }
+
+      atomic_tagged_optional_ptr(const atomic_tagged_optional_ptr&) = delete;
+      auto operator=(const atomic_tagged_optional_ptr&) -> atomic_tagged_optional_ptr& = delete;
+
+      [[nodiscard]] auto load(const std::memory_order order = std::memory_order_seq_cst) const noexcept -> value_type
+      {
+         return value_type::from_word(m_word.load(order));
+      }
+
+      auto store(const value_type desired, const std::memory_order order = std::memory_order_seq_cst) noexcept -> void
+      {
+         m_word.store(desired.word(), order);
+      }
+
+      auto exchange(const value_type desired, const std::memory_order order = std::memory_order_seq_cst) noexcept -> value_type
+      {
+         return value_type::from_word(m_word.exchange(desired.word(), order));
+      }
+
+      // On failure, expected is updated to the current value like std::atomic
+      auto compare_exchange_weak(value_type& expected, const value_type desired,
+         const std::memory_order order = std::memory_order_seq_cst) noexcept -> bool
+      {
+         std::uintptr_t expected_word = expected.word();
+         const bool exchanged = m_word.compare_exchange_weak(expected_word, desired.word(), order);
+         expected = value_type::from_word(expected_word);
+         return exchanged;
+      }
+
+      auto compare_exchange_strong(value_type& expected, const value_type desired,
+         const std::memory_order order = std::memory_order_seq_cst) noexcept -> bool
+      {
+         std::uintptr_t expected_word = expected.word();
+         const bool exchanged = m_word.compare_exchange_strong(expected_word, desired.word(), order);
+         expected = value_type::from_word(expected_word);
+         return exchanged;
+      }
+
+      // Return the previous value
+      auto fetch_set_flag(const unsigned bit, const std::memory_order order = std::memory_order_seq_cst) noexcept -> value_type
+      {
+         return value_type::from_word(m_word.fetch_or(value_type::flag_mask(bit), order));
+      }
+
+      auto fetch_clear_flag(const unsigned bit, const std::memory_order order = std::memory_order_seq_cst) noexcept -> value_type
+      {
+         return value_type::from_word(m_word.fetch_and(~value_type::flag_mask(bit), order));
+      }
+   };
+
+} // namespace io
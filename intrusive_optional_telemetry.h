@@ -0,0 +1,275 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string_view>
+#include <vector>
+
+#include "intrusive_optional.h"
+
+
+// Counters of intrusive_optional events per type, enabled with the telemetry policy parameter:
+// io::intrusive_optional<-1, io::safety_mode_t::unsafe, io::counting_telemetry>
+// Every thread counts into its own counters, which are merged when they're read.
+namespace io
+{
+
+   struct telemetry_counters
+   {
+      std::uint64_t value_observations = 0;
+      std::uint64_t null_observations = 0;
+      std::uint64_t sentinel_collisions = 0;
+      std::uint64_t bad_accesses = 0;
+      std::uint64_t resets = 0;
+
+      // Share of has_value() calls that returned false
+      [[nodiscard]] auto null_rate() const noexcept -> double
+      {
+         const std::uint64_t observations = value_observations + null_observations;
+         return observations == 0 ? 0.0 : static_cast<double>(null_observations) / static_cast<double>(observations);
+      }
+
+      auto operator+=(const telemetry_counters& other) noexcept -> telemetry_counters&
+      {
+         value_observations += other.value_observations;
+         null_observations += other.null_observations;
+         sentinel_collisions += other.sentinel_collisions;
+         bad_accesses += other.bad_accesses;
+         resets += other.resets;
+         return *this;
+      }
+
+      auto operator==(const telemetry_counters&) const -> bool = default;
+   };
+
+
+   struct telemetry_record
+   {
+      std::string_view type_name;
+      telemetry_counters counters;
+   };
+
+
+   namespace detail
+   {
+
+      // Name of T from the signature of this function, like "io::intrusive_optional<-1, ...>" with
+      // GCC and Clang. Other compilers get the whole signature.
+      template <typename T>
+      auto type_name() -> std::string_view
+      {
+         const std::string_view signature = std::source_location::current().function_name();
+         const std::size_t begin = signature.find("T = ");
+         if (begin == std::string_view::npos)
+         {
+            return signature;
+         }
+         const std::size_t end = signature.find_first_of(";]", begin);
+         return signature.substr(begin + 4, end == std::string_view::npos ? std::string_view::npos : end - begin - 4);
+      }
+
+
+      // Counters of one thread. Only the owning thread writes them, with a relaxed load and store
+      // instead of an atomic increment, which makes a count a plain add. Other threads can still read
+      // them at any time.
+      struct telemetry_thread_counters
+      {
+         std::array<std::atomic<std::uint64_t>, 5> counts{};
+
+         auto add(const telemetry_event event) noexcept -> void
+         {
+            std::atomic<std::uint64_t>& count = counts[static_cast<std::size_t>(event)];
+            count.store(count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+         }
+
+         [[nodiscard]] auto load() const noexcept -> telemetry_counters
+         {
+            const auto get = [&](const telemetry_event event)
+            {
+               return counts[static_cast<std::size_t>(event)].load(std::memory_order_relaxed);
+            };
+            return {
+               get(telemetry_event::value_observed),
+               get(telemetry_event::null_observed),
+               get(telemetry_event::sentinel_collision),
+               get(telemetry_event::bad_access),
+               get(telemetry_event::reset)
+            };
+         }
+      };
+
+
+      class telemetry_registry;
+
+      // All registries, for dump_telemetry()
+      struct telemetry_registry_list
+      {
+         std::mutex mutex;
+         std::vector<const telemetry_registry*> registries;
+      };
+
+      inline auto registry_list() -> telemetry_registry_list&
+      {
+         static telemetry_registry_list list;
+         return list;
+      }
+
+
+      // Counters of one optional type: Those of the running threads and the sum of the exited ones
+      class telemetry_registry
+      {
+         std::string_view m_type_name;
+         mutable std::mutex m_mutex;
+         std::vector<const telemetry_thread_counters*> m_threads;
+         telemetry_counters m_exited;
+
+      public:
+         explicit telemetry_registry(const std::string_view type_name)
+            : m_type_name(type_name)
+         {
+            telemetry_registry_list& list = registry_list();
+            const std::lock_guard lock(list.mutex);
+            list.registries.push_back(this);
+         }
+
+         ~telemetry_registry()
+         {
+            telemetry_registry_list& list = registry_list();
+            const std::lock_guard lock(list.mutex);
+            std::erase(list.registries, this);
+         }
+
+         telemetry_registry(const telemetry_registry&) = delete;
+         auto operator=(const telemetry_registry&) -> telemetry_registry& = delete;
+
+         [[nodiscard]] auto type_name() const noexcept -> std::string_view
+         {
+            return m_type_name;
+         }
+
+         auto attach(const telemetry_thread_counters& counters) -> void
+         {
+            const std::lock_guard lock(m_mutex);
+            m_threads.push_back(&counters);
+         }
+
+         auto detach(const telemetry_thread_counters& counters) -> void
+         {
+            const std::lock_guard lock(m_mutex);
+            m_exited += counters.load();
+            std::erase(m_threads, &counters);
+         }
+
+         [[nodiscard]] auto read() const -> telemetry_counters
+         {
+            const std::lock_guard lock(m_mutex);
+            telemetry_counters result = m_exited;
+            for (const telemetry_thread_counters* counters : m_threads)
+            {
+               result += counters->load();
+            }
+            return result;
+         }
+      };
+
+
+      // The counters of a thread, registered for as long as the thread runs
+      class attached_thread_counters
+      {
+         telemetry_registry& m_registry;
+
+      public:
+         telemetry_thread_counters counters;
+
+         explicit attached_thread_counters(telemetry_registry& registry)
+            : m_registry(registry)
+         {
+            m_registry.attach(counters);
+         }
+
+         ~attached_thread_counters()
+         {
+            m_registry.detach(counters);
+         }
+
+         attached_thread_counters(const attached_thread_counters&) = delete;
+         auto operator=(const attached_thread_counters&) -> attached_thread_counters& = delete;
+      };
+
+   } // namespace detail
+
+
+   // Telemetry policy that counts every event per optional type. The first event of a type in a
+   // thread registers that thread's counters, which allocates. After that, an event is an add to a
+   // thread_local counter.
+   struct counting_telemetry
+   {
+      static constexpr bool enabled = true;
+
+      template <typename optional_type>
+      static auto record(const telemetry_event event) noexcept -> void
+      {
+         thread_counters<optional_type>().add(event);
+      }
+
+      // Sum over all threads, including those that have exited
+      template <typename optional_type>
+      [[nodiscard]] static auto counters() -> telemetry_counters
+      {
+         return registry<optional_type>().read();
+      }
+
+   private:
+      template <typename optional_type>
+      static auto registry() -> detail::telemetry_registry&
+      {
+         static detail::telemetry_registry registry(detail::type_name<optional_type>());
+         return registry;
+      }
+
+      template <typename optional_type>
+      static auto thread_counters() -> detail::telemetry_thread_counters&
+      {
+         thread_local detail::attached_thread_counters attached(registry<optional_type>());
+         return attached.counters;
+      }
+   };
+
+
+   // Counters of every type that recorded an event, in the order of their first events
+   [[nodiscard]] inline auto telemetry_snapshot() -> std::vector<telemetry_record>
+   {
+      detail::telemetry_registry_list& list = detail::registry_list();
+      const std::lock_guard lock(list.mutex);
+      std::vector<telemetry_record> records;
+      records.reserve(list.registries.size());
+      for (const detail::telemetry_registry* registry : list.registries)
+      {
+         records.push_back({ registry->type_name(), registry->read() });
+      }
+      return records;
+   }
+
+
+   // One line per type, e.g.
+   // io::intrusive_optional<-1, ...>: has_value 1000 (12.5% null), collisions 3, bad accesses 1, resets 20
+   inline auto dump_telemetry(std::ostream& stream) -> void
+   {
+      for (const telemetry_record& record : telemetry_snapshot())
+      {
+         const telemetry_counters& counters = record.counters;
+         stream << record.type_name
+            << ": has_value " << counters.value_observations + counters.null_observations
+            << " (" << counters.null_rate() * 100.0 << "% null)"
+            << ", collisions " << counters.sentinel_collisions
+            << ", bad accesses " << counters.bad_accesses
+            << ", resets " << counters.resets << '\n';
+      }
+   }
+
+} // namespace io
@@ -0,0 +1,310 @@
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+
+#include "intrusive_optional_algorithms.h"
+
+
+// Range adaptors over columns of intrusive_optionals:
+// - column | io::views::engaged: References to the values of the engaged elements
+// - column | io::views::values_or(x): Every value, with x in place of nulls
+// - column | io::views::indices_engaged: Indices of the engaged elements
+namespace io
+{
+
+   namespace detail
+   {
+
+      // The views scan the column in aligned blocks. Null blocks are detected with a branch-free
+      // count that compilers vectorize for scalar value types, and skipped as a whole. Otherwise the
+      // block is compared into a bit mask. Iterators keep the mask of the current block, so
+      // advancing within a block is a bit scan.
+      constexpr inline std::size_t skip_block_size = 32;
+
+      // Whether the full block at begin is null
+      template <typename opt_type>
+      [[nodiscard]] constexpr auto is_null_block(const opt_type* data, const std::size_t begin) -> bool
+      {
+         std::uint32_t null_count = 0;
+         for (std::size_t j = 0; j < skip_block_size; ++j)
+         {
+            null_count += static_cast<std::uint32_t>(is_null(data[begin + j]));
+         }
+         return null_count == skip_block_size;
+      }
+
+      template <typename opt_type>
+      [[nodiscard]] constexpr auto engaged_mask(const opt_type* data, const std::size_t begin, const std::size_t size) -> std::uint32_t
+      {
+         std::uint32_t mask = 0;
+         if (begin + skip_block_size <= size)
+         {
+            for (std::size_t j = 0; j < skip_block_size; ++j)
+            {
+               mask |= static_cast<std::uint32_t>(is_null(data[begin + j]) == false) << j;
+            }
+         }
+         else
+         {
+            for (std::size_t j = 0; begin + j < size; ++j)
+            {
+               mask |= static_cast<std::uint32_t>(is_null(data[begin + j]) == false) << j;
+            }
+         }
+         return mask;
+      }
+
+
+      // Index of the last engaged element before i. There must be one.
+      template <typename opt_type>
+      [[nodiscard]] constexpr auto previous_engaged(const opt_type* data, const std::size_t i, const std::size_t size) -> std::size_t
+      {
+         std::size_t block = (i - 1) / skip_block_size * skip_block_size;
+         const std::size_t offset = i - block;
+         std::uint32_t mask = engaged_mask(data, block, size);
+         if (offset < skip_block_size)
+         {
+            mask &= (std::uint32_t{ 1 } << offset) - 1;
+         }
+         while (mask == 0)
+         {
+            block -= skip_block_size;
+            if (is_null_block(data, block) == false)
+            {
+               mask = engaged_mask(data, block, size);
+            }
+         }
+         return block + skip_block_size - 1 - static_cast<std::size_t>(std::countl_zero(mask));
+      }
+
+
+      // Bidirectional view over the engaged elements of a column. It yields either the values or
+      // their indices. The view refers to the column without owning it, the first engaged element
+      // is found on construction.
+      template <typename opt_type, bool yields_indices>
+      class engaged_view : public std::ranges::view_interface<engaged_view<opt_type, yields_indices>>
+      {
+      public:
+         class iterator
+         {
+            opt_type* m_data = nullptr;
+            std::size_t m_size = 0;
+            std::size_t m_index = 0;
+            std::size_t m_block = 0;
+
+            // Engaged elements of the current block after m_index
+            std::uint32_t m_mask = 0;
+
+            constexpr auto advance() -> void
+            {
+               while (m_mask == 0)
+               {
+                  m_block += skip_block_size;
+                  if (m_block >= m_size)
+                  {
+                     m_index = m_size;
+                     return;
+                  }
+                  if (m_block + skip_block_size <= m_size && is_null_block(m_data, m_block))
+                  {
+                     continue;
+                  }
+                  m_mask = engaged_mask(m_data, m_block, m_size);
+               }
+               m_index = m_block + static_cast<std::size_t>(std::countr_zero(m_mask));
+               m_mask &= m_mask - 1;
+            }
+
+         public:
+            using reference = std::conditional_t<yields_indices, std::size_t, decltype(*std::declval<opt_type&>())>;
+            using value_type = std::remove_cvref_t<reference>;
+            using difference_type = std::ptrdiff_t;
+            using iterator_concept = std::bidirectional_iterator_tag;
+            using iterator_category = std::conditional_t<yields_indices, std::input_iterator_tag, std::bidirectional_iterator_tag>;
+
+            constexpr iterator() = default;
+
+            // Iterator to the first engaged element
+            constexpr iterator(opt_type* data, const std::size_t size)
+               : m_data(data)
+               , m_size(size)
+               , m_mask(size > 0 ? engaged_mask(data, 0, size) : 0)
+            {
+               if (m_mask == 0)
+               {
+                  this->advance();
+               }
+               else
+               {
+                  m_index = static_cast<std::size_t>(std::countr_zero(m_mask));
+                  m_mask &= m_mask - 1;
+               }
+            }
+
+            // End iterator
+            constexpr iterator(opt_type* data, const std::size_t size, std::default_sentinel_t)
+               : m_data(data)
+               , m_size(size)
+               , m_index(size)
+               , m_block(size)
+            { }
+
+            constexpr auto operator*() const -> reference
+            {
+               if constexpr (yields_indices)
+                  return m_index;
+               else
+                  return *m_data[m_index];
+            }
+
+            // Index of the current element in the column
+            [[nodiscard]] constexpr auto index() const -> std::size_t
+            {
+               return m_index;
+            }
+
+            constexpr auto operator++() -> iterator&
+            {
+               this->advance();
+               return *this;
+            }
+
+            constexpr auto operator++(int) -> iterator
+            {
+               iterator result = *this;
+               ++*this;
+               return result;
+            }
+
+            constexpr auto operator--() -> iterator&
+            {
+               m_index = previous_engaged(m_data, m_index, m_size);
+               m_block = m_index / skip_block_size * skip_block_size;
+               const std::size_t offset = m_index - m_block + 1;
+               const std::uint32_t above = offset < skip_block_size ? ~((std::uint32_t{ 1 } << offset) - 1) : 0;
+               m_mask = engaged_mask(m_data, m_block, m_size) & above;
+               return *this;
+            }
+
+            constexpr auto operator--(int) -> iterator
+            {
+               iterator result = *this;
+               --*this;
+               return result;
+            }
+
+            friend constexpr auto operator==(const iterator& lhs, const iterator& rhs) -> bool
+            {
+               return lhs.m_index == rhs.m_index;
+            }
+         };
+
+      private:
+         iterator m_begin;
+         iterator m_end;
+
+      public:
+         constexpr engaged_view() = default;
+
+         constexpr explicit engaged_view(const std::span<opt_type> column)
+            : m_begin(column.data(), column.size())
+            , m_end(column.data(), column.size(), std::default_sentinel)
+         { }
+
+         [[nodiscard]] constexpr auto begin() const -> iterator
+         {
+            return m_begin;
+         }
+
+         [[nodiscard]] constexpr auto end() const -> iterator
+         {
+            return m_end;
+         }
+      };
+
+
+      template <typename fn_type>
+      struct column_adaptor : fn_type
+      {
+         template <optional_column R>
+         requires std::ranges::borrowed_range<R>
+         friend constexpr auto operator|(R&& column, const column_adaptor& adaptor)
+         {
+            return adaptor(std::forward<R>(column));
+         }
+      };
+
+
+      template <bool yields_indices>
+      struct engaged_fn
+      {
+         template <optional_column R>
+         requires std::ranges::borrowed_range<R>
+         constexpr auto operator()(R&& column) const
+         {
+            using opt_type = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+            return engaged_view<opt_type, yields_indices>(std::span<opt_type>(std::ranges::data(column), std::ranges::size(column)));
+         }
+      };
+
+
+      template <typename value_type>
+      struct value_or_fn
+      {
+         value_type m_default_value;
+
+         template <typename opt_type>
+         constexpr auto operator()(const opt_type& opt) const -> value_type
+         {
+            return is_null(opt) ? m_default_value : raw(opt);
+         }
+      };
+
+      template <typename value_type>
+      struct values_or_fn
+      {
+         value_type m_default_value;
+
+         template <optional_column R>
+         requires (std::ranges::borrowed_range<R> && std::is_convertible_v<const value_type&, column_value_t<R>>)
+         constexpr auto operator()(R&& column) const
+         {
+            using opt_type = std::remove_reference_t<std::ranges::range_reference_t<R>>;
+            using result_type = column_value_t<R>;
+            const std::span<opt_type> span(std::ranges::data(column), std::ranges::size(column));
+            return std::views::transform(span, value_or_fn<result_type>{ static_cast<result_type>(m_default_value) });
+         }
+      };
+
+   } // namespace detail
+
+
+   namespace views
+   {
+
+      constexpr inline detail::column_adaptor<detail::engaged_fn<false>> engaged{};
+
+      constexpr inline detail::column_adaptor<detail::engaged_fn<true>> indices_engaged{};
+
+      // Random access view of all values with nulls replaced. It's a std::views::transform over the
+      // column, so it keeps the category and size of the column.
+      template <typename T>
+      [[nodiscard]] constexpr auto values_or(T&& default_value)
+      {
+         using value_type = std::remove_cvref_t<T>;
+         return detail::column_adaptor<detail::values_or_fn<value_type>>{ { std::forward<T>(default_value) } };
+      }
+
+   } // namespace views
+
+} // namespace io
+
+
+template <typename opt_type, bool yields_indices>
+constexpr inline bool std::ranges::enable_borrowed_range<io::detail::engaged_view<opt_type, yields_indices>> = true;
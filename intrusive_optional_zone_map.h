@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "intrusive_optional.h"
+
+
+namespace io
+{
+
+   // Per-block statistics over a column of arithmetic intrusive_optionals: min and max of the engaged
+   // values and the number of nulls. The zone map refers to the column but doesn't own it. Writes
+   // must go through set() or reset() to keep the statistics valid.
+   template <auto null_value, std::size_t block_size = 1024>
+   requires (std::is_arithmetic_v<decltype(null_value)> && block_size > 0)
+   class zone_map
+   {
+   public:
+      using optional_type = intrusive_optional<null_value>;
+      using value_type = typename optional_type::value_type;
+
+      struct zone
+      {
+         value_type min = std::numeric_limits<value_type>::max();
+         value_type max = std::numeric_limits<value_type>::lowest();
+         std::uint32_t null_count = 0;
+
+         // Whether the block holds NaN values other than the sentinel. min and max can't see them,
+         // so these blocks always check every element.
+         bool has_nan = false;
+      };
+
+   private:
+      std::span<optional_type> m_column;
+      std::vector<zone> m_zones;
+
+   public:
+
+      constexpr explicit zone_map(const std::span<optional_type> column)
+         : m_column(column)
+         , m_zones((column.size() + block_size - 1) / block_size)
+      {
+         for (std::size_t block = 0; block < m_zones.size(); ++block)
+         {
+            this->rebuild_block(block);
+         }
+      }
+
+
+      [[nodiscard]] constexpr auto zones() const -> std::span<const zone>
+      {
+         return m_zones;
+      }
+
+
+      // Recomputes the statistics of one block. The loop selects identity elements for nulls instead
+      // of branching, which lets it run as vector min/max.
+      constexpr auto rebuild_block(const std::size_t block) -> void
+      {
+         const auto [begin, end] = this->block_bounds(block);
+         zone result;
+         std::uint32_t null_count = 0;
+         for (std::size_t i = begin; i < end; ++i)
+         {
+            const value_type value = *m_column[i];
+            const bool is_null = detail::is_null_value<null_value>(value);
+            null_count += static_cast<std::uint32_t>(is_null);
+            result.has_nan |= (is_null == false) & (value != value);
+            result.min = std::min(result.min, is_null ? std::numeric_limits<value_type>::max() : value);
+            result.max = std::max(result.max, is_null ? std::numeric_limits<value_type>::lowest() : value);
+         }
+         result.null_count = null_count;
+         m_zones[block] = result;
+      }
+
+
+      // Incremental updates only ever widen the min/max range. Skipping stays correct, a block whose
+      // range became too wide can be tightened with rebuild_block().
+      constexpr auto set(const std::size_t index, const value_type& value) -> void
+      {
+         if (detail::is_null_value<null_value>(value))
+         {
+            this->reset(index);
+            return;
+         }
+         zone& target = m_zones[index / block_size];
+         if (m_column[index].has_value() == false)
+         {
+            --target.null_count;
+         }
+         *m_column[index] = value;
+         target.has_nan |= value != value;
+         target.min = std::min(target.min, value);
+         target.max = std::max(target.max, value);
+      }
+
+
+      constexpr auto reset(const std::size_t index) -> void
+      {
+         if (m_column[index].has_value())
+         {
+            ++m_zones[index / block_size].null_count;
+            m_column[index].reset();
+         }
+      }
+
+
+      // Calls fn(index, value) for every engaged value in [lo, hi]. Blocks that are all null or
+      // whose range doesn't intersect [lo, hi] are skipped. Blocks that lie completely inside the
+      // range and don't contain nulls skip the per-element predicate.
+      template <typename fn_type>
+      constexpr auto scan_where(const value_type& lo, const value_type& hi, fn_type&& fn) const -> void
+      {
+         for (std::size_t block = 0; block < m_zones.size(); ++block)
+         {
+            const zone& current = m_zones[block];
+            const auto [begin, end] = this->block_bounds(block);
+            if (current.null_count == end - begin || current.max < lo || current.min > hi)
+            {
+               continue;
+            }
+
+            if (current.null_count == 0 && current.has_nan == false && lo <= current.min && current.max <= hi)
+            {
+               for (std::size_t i = begin; i < end; ++i)
+               {
+                  fn(i, *m_column[i]);
+               }
+               continue;
+            }
+
+            for (std::size_t i = begin; i < end; ++i)
+            {
+               const value_type value = *m_column[i];
+               if (detail::is_null_value<null_value>(value) == false && lo <= value && value <= hi)
+               {
+                  fn(i, value);
+               }
+            }
+         }
+      }
+
+
+      // Number of engaged values in [lo, hi]
+      [[nodiscard]] constexpr auto count_where(const value_type& lo, const value_type& hi) const -> std::size_t
+      {
+         std::size_t result = 0;
+         this->scan_where(lo, hi, [&](std::size_t, const value_type&) { ++result; });
+         return result;
+      }
+
+
+   private:
+      struct bounds
+      {
+         std::size_t begin;
+         std::size_t end;
+      };
+
+      [[nodiscard]] constexpr auto block_bounds(const std::size_t block) const -> bounds
+      {
+         const std::size_t begin = block * block_size;
+         return { begin, std::min(begin + block_size, m_column.size()) };
+      }
+
+   }; // zone_map
+
+} // namespace io
@@ -0,0 +1,111 @@
+# Usage: cmake -DOBJDUMP=<path> -DOBJECT=<path> -DEXPECTATIONS=<path> -P check_codegen.cmake
+#
+# Disassembles OBJECT and checks every function listed in EXPECTATIONS: It must exist, must not
+# contain branches or calls, and must not exceed its maximum instruction count. Functions marked
+# "hot" may branch to a failure path: Only their instructions up to the first ret are checked, and
+# those must not contain calls. Split-off .cold parts are ignored. "function = other" requires
+# function to consist of the same instructions as other, with symbol names and addresses removed.
+
+foreach(variable OBJDUMP OBJECT EXPECTATIONS)
+   if(NOT DEFINED ${variable})
+      message(FATAL_ERROR "${variable} is not set")
+   endif()
+endforeach()
+
+execute_process(
+   COMMAND ${OBJDUMP} -d --no-show-raw-insn -M intel ${OBJECT}
+   OUTPUT_VARIABLE disassembly
+   RESULT_VARIABLE objdump_result
+)
+if(NOT objdump_result EQUAL 0)
+   message(FATAL_ERROR "objdump failed on ${OBJECT}")
+endif()
+
+# Split the disassembly into functions
+string(REPLACE ";" "\;" disassembly "${disassembly}")
+string(REPLACE "\n" ";" lines "${disassembly}")
+set(current "")
+foreach(line IN LISTS lines)
+   if(line MATCHES "^[0-9a-f]+ <([^>]+)>:$")
+      set(current "")
+      set(symbol "${CMAKE_MATCH_1}")
+      if(symbol MATCHES "^[A-Za-z0-9_]+$")
+         set(current "${symbol}")
+         set(count_${current} 0)
+         set(bad_${current} "")
+         set(hot_count_${current} 0)
+         set(hot_bad_${current} "")
+         set(hot_done_${current} FALSE)
+         set(text_${current} "")
+      endif()
+   elseif(current AND line MATCHES "^ +[0-9a-f]+:\t(([a-z0-9]+).*)$")
+      set(instruction "${CMAKE_MATCH_1}")
+      set(mnemonic "${CMAKE_MATCH_2}")
+      if(mnemonic MATCHES "^(nop|xchg|data16|cs|endbr64|int3)$")
+         continue()
+      endif()
+      math(EXPR count_${current} "${count_${current}} + 1")
+      # Without comments, absolute addresses and symbol names, but with offsets into the function
+      string(REGEX REPLACE " *#.*$" "" instruction "${instruction}")
+      string(REGEX REPLACE "[0-9a-f]+ <[^+>]*" "<" instruction "${instruction}")
+      string(REGEX REPLACE "[ \t]+" " " instruction "${instruction}")
+      list(APPEND text_${current} "${instruction}")
+      if(mnemonic MATCHES "^(j[a-z]*|call|loop[a-z]*)$")
+         list(APPEND bad_${current} "${mnemonic}")
+      endif()
+      if(NOT hot_done_${current})
+         math(EXPR hot_count_${current} "${hot_count_${current}} + 1")
+         if(mnemonic MATCHES "^(call|jmp)$")
+            list(APPEND hot_bad_${current} "${mnemonic}")
+         elseif(mnemonic STREQUAL "ret")
+            set(hot_done_${current} TRUE)
+         endif()
+      endif()
+   endif()
+endforeach()
+
+file(STRINGS ${EXPECTATIONS} expectations REGEX "^[A-Za-z]")
+set(failures 0)
+foreach(expectation IN LISTS expectations)
+   if(expectation MATCHES "^([A-Za-z0-9_]+) *= *([A-Za-z0-9_]+)")
+      set(function "${CMAKE_MATCH_1}")
+      set(other "${CMAKE_MATCH_2}")
+      if(NOT DEFINED count_${function} OR NOT DEFINED count_${other})
+         message(SEND_ERROR "${function} = ${other}: not found in the object file")
+         math(EXPR failures "${failures} + 1")
+      elseif(NOT text_${function} STREQUAL text_${other})
+         message(SEND_ERROR "${function}: differs from ${other}:\n  ${text_${function}}\n  ${text_${other}}")
+         math(EXPR failures "${failures} + 1")
+      else()
+         message(STATUS "${function}: same as ${other}")
+      endif()
+      continue()
+   endif()
+   string(REGEX MATCH "^([A-Za-z0-9_]+) +([0-9]+)( +hot)?" _ "${expectation}")
+   set(function "${CMAKE_MATCH_1}")
+   set(maximum "${CMAKE_MATCH_2}")
+   set(hot "${CMAKE_MATCH_3}")
+   if(NOT DEFINED count_${function})
+      message(SEND_ERROR "${function}: not found in the object file")
+      math(EXPR failures "${failures} + 1")
+      continue()
+   endif()
+   if(hot)
+      set(count_${function} ${hot_count_${function}})
+      set(bad_${function} "${hot_bad_${function}}")
+   endif()
+   if(bad_${function})
+      message(SEND_ERROR "${function}: contains branches or calls: ${bad_${function}}")
+      math(EXPR failures "${failures} + 1")
+   endif()
+   if(count_${function} GREATER maximum)
+      message(SEND_ERROR "${function}: ${count_${function}} instructions, expected at most ${maximum}")
+      math(EXPR failures "${failures} + 1")
+   else()
+      message(STATUS "${function}: ${count_${function}} instructions")
+   endif()
+endforeach()
+
+if(failures GREATER 0)
+   message(FATAL_ERROR "${failures} codegen regressions")
+endif()
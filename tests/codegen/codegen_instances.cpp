@@ -0,0 +1,149 @@
+// Non-inlined instantiations of the hot members. The codegen test disassembles this translation
+// unit and checks each function against tests/codegen/expectations.txt. All functions take the
+// optionals by pointer so that the checks don't depend on how the ABI passes small structs.
+
+#include "../../intrusive_optional.h"
+#include "../../intrusive_optional_failure.h"
+
+#include <limits>
+#include <new>
+
+
+namespace
+{
+   using opt_int = io::intrusive_optional<-1>;
+   using opt_double = io::intrusive_optional<std::numeric_limits<double>::max()>;
+   using opt_pointer = io::intrusive_optional<static_cast<int*>(nullptr)>;
+   using opt_nan = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+
+   // Built with NDEBUG, so these must compile to the same code as their unsafe counterparts
+   using opt_debug_int = io::intrusive_optional<-1, io::safety_mode_t::debug>;
+   using opt_debug_double = io::intrusive_optional<std::numeric_limits<double>::max(), io::safety_mode_t::debug>;
+}
+
+
+#define IO_CODEGEN_INSTANCES(suffix, opt_type)                                                     \
+   extern "C" auto io_has_value_##suffix(const opt_type* opt) -> bool                             \
+   {                                                                                              \
+      return opt->has_value();                                                                    \
+   }                                                                                              \
+   extern "C" auto io_deref_##suffix(const opt_type* opt) -> opt_type::value_type                 \
+   {                                                                                              \
+      return **opt;                                                                               \
+   }                                                                                              \
+   extern "C" auto io_reset_##suffix(opt_type* opt) -> void                                       \
+   {                                                                                              \
+      opt->reset();                                                                               \
+   }                                                                                              \
+   extern "C" auto io_copy_construct_##suffix(opt_type* target, const opt_type* source) -> void  \
+   {                                                                                              \
+      ::new (static_cast<void*>(target)) opt_type(*source);                                       \
+   }                                                                                              \
+   extern "C" auto io_move_construct_##suffix(opt_type* target, opt_type* source) -> void        \
+   {                                                                                              \
+      ::new (static_cast<void*>(target)) opt_type(static_cast<opt_type&&>(*source));              \
+   }                                                                                              \
+   extern "C" auto io_copy_assign_##suffix(opt_type* target, const opt_type* source) -> void     \
+   {                                                                                              \
+      *target = *source;                                                                          \
+   }                                                                                              \
+   extern "C" auto io_move_assign_##suffix(opt_type* target, opt_type* source) -> void           \
+   {                                                                                              \
+      *target = static_cast<opt_type&&>(*source);                                                 \
+   }                                                                                              \
+   extern "C" auto io_swap_##suffix(opt_type* first, opt_type* second) -> void                   \
+   {                                                                                              \
+      first->swap(*second);                                                                       \
+   }
+
+IO_CODEGEN_INSTANCES(int, opt_int)
+IO_CODEGEN_INSTANCES(double, opt_double)
+IO_CODEGEN_INSTANCES(pointer, opt_pointer)
+IO_CODEGEN_INSTANCES(nan, opt_nan)
+IO_CODEGEN_INSTANCES(debug_int, opt_debug_int)
+IO_CODEGEN_INSTANCES(debug_double, opt_debug_double)
+
+
+// The members that debug mode checks with IO_DEBUG_CHECKS, and the mutable ones it shares with
+// unsafe mode
+#define IO_CODEGEN_CHECKED_INSTANCES(suffix, opt_type)                                             \
+   extern "C" auto io_deref_mutable_##suffix(opt_type* opt) -> opt_type::value_type*             \
+   {                                                                                              \
+      return &**opt;                                                                              \
+   }                                                                                              \
+   extern "C" auto io_arrow_##suffix(const opt_type* opt) -> const opt_type::value_type*         \
+   {                                                                                              \
+      return opt->operator->();                                                                   \
+   }                                                                                              \
+   extern "C" auto io_value_mutable_##suffix(opt_type* opt) -> opt_type::value_type*             \
+   {                                                                                              \
+      return &opt->value();                                                                       \
+   }                                                                                              \
+   extern "C" auto io_emplace_##suffix(opt_type* opt, const opt_type::value_type value) -> void  \
+   {                                                                                              \
+      opt->emplace(value);                                                                        \
+   }
+
+IO_CODEGEN_CHECKED_INSTANCES(int, opt_int)
+IO_CODEGEN_CHECKED_INSTANCES(debug_int, opt_debug_int)
+
+
+// Failure paths per failure policy. They're checked as "hot": The compare and the branch to the
+// failure, which the compiler moves out of the way, must be the same for every policy.
+namespace
+{
+   using opt_int_abort = io::intrusive_optional<-1, io::safety_mode_t::unsafe, io::no_telemetry, io::abort_on_failure>;
+   using opt_int_callback = io::intrusive_optional<-1, io::safety_mode_t::unsafe, io::no_telemetry, io::callback_on_failure>;
+   using opt_safe_int = io::intrusive_optional<-1, io::safety_mode_t::safe>;
+   using opt_safe_int_abort = io::intrusive_optional<-1, io::safety_mode_t::safe, io::no_telemetry, io::abort_on_failure>;
+}
+
+#define IO_CODEGEN_FAILURE_INSTANCES(suffix, opt_type, safe_opt_type)                              \
+   extern "C" auto io_value_##suffix(const opt_type* opt) -> int                                  \
+   {                                                                                              \
+      return opt->value();                                                                        \
+   }                                                                                              \
+   extern "C" auto io_emplace_safe_##suffix(safe_opt_type* opt, const int value) -> void         \
+   {                                                                                              \
+      opt->emplace(value);                                                                        \
+   }
+
+IO_CODEGEN_FAILURE_INSTANCES(int_throw, opt_int, opt_safe_int)
+IO_CODEGEN_FAILURE_INSTANCES(int_abort, opt_int_abort, opt_safe_int_abort)
+
+extern "C" auto io_value_int_callback(const opt_int_callback* opt) -> int
+{
+   return opt->value();
+}
+
+extern "C" auto io_try_value_int(const opt_int* opt) -> int
+{
+   const io::value_result<const int> result = opt->try_value();
+   return result ? *result : 0;
+}
+
+extern "C" auto io_try_emplace_int(opt_int* opt, const int value) -> io::optional_errc
+{
+   return opt->try_emplace(value);
+}
+
+
+// Layout and triviality. These break the build directly.
+#define IO_CODEGEN_TRAITS(opt_type)                                                                \
+   static_assert(sizeof(opt_type) == sizeof(opt_type::value_type));                                \
+   static_assert(alignof(opt_type) == alignof(opt_type::value_type));                              \
+   static_assert(std::is_trivially_copyable_v<opt_type>);                                          \
+   static_assert(std::is_trivially_copy_constructible_v<opt_type>);                                \
+   static_assert(std::is_trivially_move_constructible_v<opt_type>);                                \
+   static_assert(std::is_trivially_copy_assignable_v<opt_type>);                                   \
+   static_assert(std::is_trivially_move_assignable_v<opt_type>);                                   \
+   static_assert(std::is_trivially_destructible_v<opt_type>);                                      \
+   static_assert(std::is_nothrow_copy_constructible_v<opt_type>);                                  \
+   static_assert(std::is_nothrow_move_constructible_v<opt_type>);
+
+IO_CODEGEN_TRAITS(opt_int)
+IO_CODEGEN_TRAITS(opt_double)
+IO_CODEGEN_TRAITS(opt_pointer)
+IO_CODEGEN_TRAITS(opt_nan)
+IO_CODEGEN_TRAITS(opt_debug_int)
+IO_CODEGEN_TRAITS(opt_debug_double)
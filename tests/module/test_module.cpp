@@ -0,0 +1,24 @@
+// Imports the module instead of including the header. Built with IO_BUILD_MODULE.
+#include <functional>
+#include <optional>
+
+import io.intrusive_optional;
+
+
+auto main() -> int
+{
+   io::intrusive_optional<-1> a{ 5 };
+   io::intrusive_optional<-1> b;
+   if (b.has_value() || b != std::nullopt)
+      return 1;
+
+   const io::intrusive_optional<-2> c(a);
+   b = c;
+   if (a != b || *b != 5 || (a < c))
+      return 1;
+
+   if (std::hash<io::intrusive_optional<-1>>{}(a) != std::hash<int>{}(5))
+      return 1;
+
+   return io::make_optional<-1>(3).value_or(0) == 3 ? 0 : 1;
+}
@@ -0,0 +1,86 @@
+// Built with -fno-exceptions. Instantiates the members that can fail with the default and the
+// aborting failure policy, so that nothing in them throws directly.
+#include "../../intrusive_optional.h"
+#include "../../intrusive_optional_by_member.h"
+#include "../../intrusive_optional_failure.h"
+#include "../../intrusive_optional_gapped_array.h"
+#include "../../intrusive_optional_packed_array.h"
+#include "../../intrusive_optional_padding.h"
+#include "../../intrusive_optional_slot_map.h"
+#include "../../intrusive_optional_tagged_ptr.h"
+
+#include <cstddef>
+#include <vector>
+
+
+namespace
+{
+
+   struct record
+   {
+      int id = 0;
+      double score = 0.0;
+   };
+
+   struct int_char
+   {
+      int i;
+      char c;
+   };
+
+   template <typename failure_policy>
+   auto run() -> bool
+   {
+      io::intrusive_optional<-1, io::safety_mode_t::safe, io::no_telemetry, failure_policy> opt(5);
+      opt.emplace(6);
+      if (opt.value() != 6)
+         return false;
+
+      io::intrusive_optional_by_member<&record::id, -1, io::safety_mode_t::safe, failure_policy> by_member(record{ 1, 0.5 });
+      by_member.emplace(2, 1.0);
+      if (by_member.value().id != 2)
+         return false;
+
+      io::intrusive_optional_by_member<&record::id, -1, io::safety_mode_t::unsafe, failure_policy> unsafe_by_member;
+      unsafe_by_member = record{ 3, 0.0 };
+      if (unsafe_by_member.value().id != 3)
+         return false;
+
+      io::slot_map<-1, failure_policy> slots;
+      const io::slot_handle handle = slots.insert(7);
+      if (slots.find(handle) == nullptr || *slots.find(handle) != 7)
+         return false;
+
+      io::gapped_sorted_array<-1, 32, failure_policy> sorted;
+      sorted.insert(9);
+      sorted.insert(8);
+      if (sorted.contains(8) == false || sorted.contains(9) == false)
+         return false;
+
+      static int target = 4;
+      const io::tagged_optional_ptr<int, 2, failure_policy> tagged(&target, 1);
+      const io::atomic_tagged_optional_ptr<int, 2, failure_policy> atomic_tagged(tagged);
+      if (atomic_tagged.load().value() != 4)
+         return false;
+
+      const io::padding_optional<int_char, offsetof(int_char, c) + sizeof(char), failure_policy> padded(int_char{ 5, 'a' });
+      if (padded.value().i != 5)
+         return false;
+
+      using packed_type = io::packed_optional_array<5, 31, failure_policy>;
+      packed_type packed(4);
+      packed[1] = 6;
+      packed.push_back(typename packed_type::optional_type{ 7 });
+      std::vector<typename packed_type::optional_type> unpacked(5);
+      packed.unpack(0, unpacked);
+      packed.pack(0, unpacked);
+      return packed[1].value() == 6 && packed[4].value() == 7;
+   }
+
+} // namespace {}
+
+
+auto main() -> int
+{
+   return run<io::throw_on_failure>() && run<io::abort_on_failure>() ? 0 : 1;
+}
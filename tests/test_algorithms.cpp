@@ -0,0 +1,90 @@
+#include "test_algorithms.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_algorithms.h"
+
+#include <limits>
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<-1>;
+
+   auto make_column(const std::vector<int>& values) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(values.size());
+      for (std::size_t i = 0; i < values.size(); ++i)
+      {
+         if (values[i] != -1)
+            result[i].emplace(values[i]);
+      }
+      return result;
+   }
+
+
+   auto test_null_helpers()-> void
+   {
+      std::vector<opt_type> column = make_column({ 1, -1, 3, -1, -1 });
+      io::assert(io::count_null(column) == 3);
+      io::fill_null(column);
+      io::assert(io::count_null(column) == column.size());
+   }
+
+
+   auto test_swap_ranges()-> void
+   {
+      {
+         std::vector<opt_type> first = make_column({ 1, -1, 3 });
+         std::vector<opt_type> second = make_column({ -1, 5, 6, 7 });
+         io::assert(io::swap_ranges(first, second) == 3);
+         io::assert(first == make_column({ -1, 5, 6 }));
+         io::assert(second == make_column({ 1, -1, 3, 7 }));
+      }
+      {
+         std::vector<two_values_optional> first(2);
+         std::vector<two_values_optional> second(2);
+         first[0].emplace(1, 2);
+         second[1].emplace(3, 4);
+         io::swap_ranges(first, second);
+         io::assert(first[0].has_value() == false && *first[1] == io::two_values(3, 4));
+         io::assert(*second[0] == io::two_values(1, 2) && second[1].has_value() == false);
+      }
+   }
+
+
+   auto test_rotate()-> void
+   {
+      for (std::size_t middle = 0; middle <= 5; ++middle)
+      {
+         const std::vector<int> values{ 1, -1, 3, 4, -1 };
+         std::vector<opt_type> column = make_column(values);
+         std::vector<opt_type> expected = make_column(values);
+         const std::size_t expected_index = static_cast<std::size_t>(std::rotate(expected.begin(), expected.begin() + middle, expected.end()) - expected.begin());
+         io::assert(io::rotate(column, middle) == expected_index);
+         io::assert(column == expected);
+      }
+   }
+
+
+   // A NaN sentinel never compares equal, the kernels must test nulls bitwise
+   auto test_nan_sentinel()-> void
+   {
+      using nan_opt = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+      std::vector<nan_opt> column(4);
+      column[1] = 2.0;
+      io::assert(io::count_null(column) == 3);
+      io::fill_null(column);
+      io::assert(io::count_null(column) == 4);
+   }
+   
+} // namespace {}
+
+
+auto io::test_algorithms() -> void
+{
+   test_null_helpers();
+   test_swap_ranges();
+   test_rotate();
+   test_nan_sentinel();
+}
@@ -53,7 +53,7 @@ namespace
          constexpr auto generator = []()
          {
             io::intrusive_optional<5> value;
-            value = 5ui8;
+            value = std::uint8_t{ 5 };
             return value;
          };
          static_assert(*generator() == 5);
@@ -64,7 +64,7 @@ namespace
    constexpr auto test_5()-> void
    {
       using opt_type_a = io::intrusive_optional<10>;
-      using opt_type_b = io::intrusive_optional<10ui8>;
+      using opt_type_b = io::intrusive_optional<std::uint8_t{ 10 }>;
       {
          opt_type_b first;
          opt_type_a second;
@@ -72,7 +72,7 @@ namespace
          io::assert(second.has_value() == false);;
       }
       {
-         opt_type_b first(5ui8);
+         opt_type_b first(std::uint8_t{ 5 });
          opt_type_a second;
          second = first;
          io::assert(*second == 5);;
@@ -83,7 +83,7 @@ namespace
    constexpr auto test_6()-> void
    {
       using opt_type_a = io::intrusive_optional<10>;
-      using opt_type_b = io::intrusive_optional<10ui8>;
+      using opt_type_b = io::intrusive_optional<std::uint8_t{ 10 }>;
       {
          opt_type_b first;
          opt_type_a second;
@@ -91,7 +91,7 @@ namespace
          io::assert(second.has_value() == false);;
       }
       {
-         opt_type_b first(5ui8);
+         opt_type_b first(std::uint8_t{ 5 });
          opt_type_a second;
          second = std::move(first);
          io::assert(*second == 5);;
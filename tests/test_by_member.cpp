@@ -0,0 +1,149 @@
+#include "test_by_member.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_by_member.h"
+
+#include <stdexcept>
+#include <string>
+
+
+namespace
+{
+
+   // Not structural because of the std::string
+   struct record
+   {
+      int id = 0;
+      std::string name;
+      double score = 0.0;
+
+      auto operator==(const record&) const -> bool = default;
+   };
+
+   struct point
+   {
+      int x = 0;
+      int y = 0;
+      constexpr auto operator==(const point&) const -> bool = default;
+   };
+
+   // Constructor that throws for ids below -1
+   struct checked_record
+   {
+      int id = 0;
+      std::string name;
+
+      checked_record() = default;
+      checked_record(int id_param, std::string name_param)
+         : id(id_param)
+         , name(std::move(name_param))
+      {
+         if (id < -1)
+            throw std::invalid_argument("id below -1");
+      }
+   };
+
+   using opt_record = io::intrusive_optional_by_member<&record::id, -1>;
+   using opt_point = io::intrusive_optional_by_member<&point::x, -1>;
+
+   static_assert(sizeof(opt_record) == sizeof(record));
+   static_assert(std::is_same_v<opt_record::value_type, record>);
+   static_assert(std::is_same_v<opt_record::member_type, int>);
+   static_assert(std::is_trivially_copyable_v<opt_point>);
+   static_assert(io::is_trivially_relocatable_v<opt_point>);
+
+   static_assert(opt_point().has_value() == false);
+   static_assert(opt_point(point{ 1, 2 }).has_value());
+   static_assert(opt_point(point{ -1, 2 }).has_value() == false);
+   static_assert(opt_point(point{ 1, 2 }) == opt_point(point{ 1, 2 }));
+   static_assert(opt_point(point{ -1, 2 }) == opt_point(point{ -1, 3 }));
+   static_assert(opt_point() == std::nullopt);
+
+
+   auto test_basics()-> void
+   {
+      opt_record opt;
+      io::assert(opt.has_value() == false);
+      io::assert(opt->id == -1);
+
+      opt = record{ 1, "one", 0.5 };
+      io::assert(opt.has_value());
+      io::assert(opt->name == "one");
+      io::assert(opt.value().score == 0.5);
+
+      // reset() only writes the id
+      opt.reset();
+      io::assert(opt.has_value() == false);
+      io::assert(opt->name == "one");
+
+      opt.emplace(2, "two", 1.0);
+      io::assert(opt->id == 2);
+      io::assert(opt.get_std().has_value());
+      io::assert(opt.value_or(record{}).name == "two");
+
+      opt_record other;
+      opt.swap(other);
+      io::assert(opt.has_value() == false);
+      io::assert(other->name == "two");
+
+      bool thrown = false;
+      try
+      {
+         (void)opt.value();
+      }
+      catch (const std::bad_optional_access&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+
+   auto test_safe_mode()-> void
+   {
+      using safe_type = io::intrusive_optional_by_member<&record::id, -1, io::safety_mode_t::safe>;
+      safe_type opt(record{ 1, "one", 0.5 });
+      io::assert(opt.has_value());
+      bool thrown = false;
+      try
+      {
+         opt = record{ -1, "null", 0.0 };
+      }
+      catch (const io::unintentionally_null&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+
+   auto test_throwing_emplace()-> void
+   {
+      using opt_checked = io::intrusive_optional_by_member<&checked_record::id, -1>;
+      opt_checked opt;
+      opt.emplace(1, "one");
+      bool thrown = false;
+      try
+      {
+         opt.emplace(-2, "minus two");
+      }
+      catch (const std::invalid_argument&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+
+      // The old record is still alive and gets destroyed once
+      io::assert(opt.has_value());
+      io::assert(opt->name == "one");
+   }
+
+} // namespace {}
+
+
+auto io::test_by_member() -> void
+{
+   test_basics();
+   test_safe_mode();
+   test_throwing_emplace();
+}
@@ -0,0 +1,135 @@
+#include "test_codecs.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_codecs.h"
+
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<std::int64_t{ -1 }>;
+
+   auto make_column() -> std::vector<opt_type>
+   {
+      std::vector<opt_type> column(200);
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+         if (i % 7 == 0 || (i > 50 && i < 120))
+            continue;
+         column[i].emplace(static_cast<std::int64_t>(1000 + i % 13));
+      }
+      return column;
+   }
+
+
+   auto test_null_runs()-> void
+   {
+      const std::vector<opt_type> column = make_column();
+      const auto block = io::encode_null_runs(column);
+      io::assert(block.size == column.size());
+      io::assert(block.values.size() == column.size() - io::count_null(column));
+
+      std::vector<opt_type> decoded(column.size(), opt_type(5));
+      io::decode_null_runs(block, decoded);
+      io::assert(decoded == column);
+   }
+
+
+   auto test_frame_of_reference()-> void
+   {
+      {
+         const std::vector<opt_type> column = make_column();
+         const auto block = io::encode_frame_of_reference(column);
+         io::assert(block.reference == 1000);
+         io::assert(block.codes.bits == 4);
+
+         std::vector<opt_type> decoded(column.size());
+         io::decode_frame_of_reference(block, decoded);
+         io::assert(decoded == column);
+      }
+
+      // Frame spanning the entire value range
+      {
+         using small_opt_type = io::intrusive_optional<std::int8_t{ 0 }>;
+         const std::vector<small_opt_type> column{ small_opt_type(std::int8_t{ -128 }), small_opt_type{}, small_opt_type(std::int8_t{ 127 }) };
+         const auto block = io::encode_frame_of_reference(column);
+         std::vector<small_opt_type> decoded(column.size());
+         io::decode_frame_of_reference(block, decoded);
+         io::assert(decoded == column);
+      }
+
+      // All null
+      {
+         const std::vector<opt_type> column(10);
+         const auto block = io::encode_frame_of_reference(column);
+         std::vector<opt_type> decoded(column.size(), opt_type(3));
+         io::decode_frame_of_reference(block, decoded);
+         io::assert(io::count_null(decoded) == decoded.size());
+      }
+   }
+
+
+   auto test_dictionary()-> void
+   {
+      const std::vector<opt_type> column = make_column();
+      const auto block = io::encode_dictionary(column);
+      io::assert(block.dictionary.size() == 14);
+      io::assert(block.dictionary.front() == opt_type::null_value);
+
+      std::vector<opt_type> decoded(column.size());
+      io::decode_dictionary(block, decoded);
+      io::assert(decoded == column);
+   }
+
+
+   // NaN values are ordered and deduplicated bitwise, -0.0 and 0.0 are distinct entries
+   auto test_dictionary_nan()-> void
+   {
+      using double_type = io::intrusive_optional<std::numeric_limits<double>::max()>;
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      const std::vector<double_type> column{ 1.0, nan, double_type{}, -0.0, nan, 0.0, 1.0, -nan };
+      const auto block = io::encode_dictionary(column);
+      io::assert(block.dictionary.size() == 6);
+
+      std::vector<double_type> decoded(column.size());
+      io::decode_dictionary(block, decoded);
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+         io::assert(std::bit_cast<std::uint64_t>(*decoded[i]) == std::bit_cast<std::uint64_t>(*column[i]));
+      }
+   }
+
+
+   auto test_size_mismatch()-> void
+   {
+      const std::vector<opt_type> column = make_column();
+      const auto block = io::encode_null_runs(column);
+      std::vector<opt_type> decoded(column.size() - 1);
+      bool has_thrown = false;
+      try
+      {
+         io::decode_null_runs(block, decoded);
+      }
+      catch (const io::codec_size_mismatch&)
+      {
+         has_thrown = true;
+      }
+      io::assert(has_thrown);
+   }
+   
+} // namespace {}
+
+
+auto io::test_codecs() -> void
+{
+   test_null_runs();
+   test_frame_of_reference();
+   test_dictionary();
+   test_dictionary_nan();
+   test_size_mismatch();
+}
@@ -0,0 +1,87 @@
+#include "test_compact.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_compact.h"
+
+#include <cmath>
+#include <limits>
+
+
+namespace
+{
+
+   enum class color : std::uint8_t { red, green, blue };
+   enum class ends : std::int8_t { low = -128, high = 127 };
+
+   struct user_id
+   {
+      int value{};
+      constexpr auto operator==(const user_id&) const -> bool = default;
+   };
+
+} // namespace {}
+
+
+template <>
+struct io::niche_traits<user_id>
+{
+   static constexpr user_id null_value{ -1 };
+};
+
+
+namespace
+{
+
+   static_assert(std::is_same_v<io::compact_optional<int*>, io::intrusive_optional<static_cast<int*>(nullptr)>>);
+   static_assert(sizeof(io::compact_optional<double>) == sizeof(double));
+   static_assert(sizeof(io::compact_optional<float>) == sizeof(float));
+   static_assert(sizeof(io::compact_optional<color>) == 1);
+   static_assert(io::niche_traits<color>::null_value == static_cast<color>(255));
+   static_assert(io::niche_traits<ends>::null_value == static_cast<ends>(126));
+   static_assert(sizeof(io::compact_optional<user_id>) == sizeof(user_id));
+
+   // Integers and bool use all their values
+   static_assert(io::has_niche<int> == false);
+   static_assert(io::has_niche<bool> == false);
+   static_assert(std::is_same_v<io::compact_optional<int, io::niche_fallback::std_optional>, std::optional<int>>);
+
+   static_assert(io::compact_optional<color>(color::blue).has_value());
+   static_assert(io::compact_optional<color>().has_value() == false);
+   static_assert(io::compact_optional<double>().has_value() == false);
+   static_assert(io::compact_optional<double>(1.0) == 1.0);
+
+
+   auto test_nan_niche()-> void
+   {
+      using opt_type = io::compact_optional<double>;
+      opt_type opt;
+      io::assert(opt.has_value() == false);
+      opt = 2.0;
+      io::assert(opt.has_value());
+      opt.reset();
+      io::assert(opt.has_value() == false);
+
+      // NaNs other than the canonical one are values
+      const double other_nan = -std::numeric_limits<double>::quiet_NaN();
+      opt = other_nan;
+      io::assert(opt.has_value());
+      io::assert(std::isnan(*opt));
+   }
+
+
+   auto test_user_niche()-> void
+   {
+      io::compact_optional<user_id> id;
+      io::assert(id.has_value() == false);
+      id.emplace(user_id{ 3 });
+      io::assert(id->value == 3);
+   }
+
+} // namespace {}
+
+
+auto io::test_compact() -> void
+{
+   test_nan_niche();
+   test_user_niche();
+}
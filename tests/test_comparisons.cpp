@@ -23,11 +23,11 @@ namespace
          constexpr two_values_optional first(std::in_place, 2, 5);
          constexpr two_values_optional second(std::in_place, 3, 5);
          static_assert(first < second);
-         static_assert(first < first == false);
+         static_assert((first < first) == false);
          static_assert(first <= first);
 
          static_assert(second > first);
-         static_assert(second > second == false);
+         static_assert((second > second) == false);
          static_assert(second >= second);
       }
 
@@ -0,0 +1,145 @@
+#include "test_convert.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_convert.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+
+   using opt_i64 = io::intrusive_optional<std::int64_t{ -1 }>;
+   using opt_i32 = io::intrusive_optional<std::numeric_limits<std::int32_t>::max()>;
+   using opt_u8 = io::intrusive_optional<std::uint8_t{ 0 }>;
+   using opt_double = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+   using opt_float = io::intrusive_optional<-1.0f>;
+
+
+   template <typename to_type>
+   constexpr auto saturated(const auto value) -> to_type
+   {
+      bool out_of_range = false;
+      return io::detail::saturating_convert<to_type>(value, to_type{}, out_of_range);
+   }
+
+   static_assert(saturated<std::int32_t>(std::int64_t{ 1 } << 40) == std::numeric_limits<std::int32_t>::max());
+   static_assert(saturated<std::uint8_t>(std::int64_t{ -5 }) == 0);
+   static_assert(saturated<std::uint8_t>(300) == 255);
+   static_assert(saturated<std::int8_t>(std::uint32_t{ 7 }) == 7);
+   static_assert(saturated<std::int32_t>(-1e30) == std::numeric_limits<std::int32_t>::min());
+   static_assert(saturated<std::int32_t>(2147483648.0) == std::numeric_limits<std::int32_t>::max());
+   static_assert(saturated<std::int32_t>(2147483647.0) == std::numeric_limits<std::int32_t>::max());
+   static_assert(saturated<std::int32_t>(-2.5) == -2);
+   static_assert(saturated<float>(1e300) == std::numeric_limits<float>::max());
+
+
+   auto test_narrowing() -> void
+   {
+      const std::vector<opt_i64> input{ opt_i64{ 1 }, opt_i64{}, opt_i64{ std::int64_t{ 1 } << 40 }, opt_i64{ -(std::int64_t{ 1 } << 40) }, opt_i64{ -7 } };
+      std::vector<opt_i32> output(input.size());
+
+      const io::conversion_report report = io::convert_column(input, output);
+      io::assert(*output[0] == 1);
+      io::assert(output[1].has_value() == false);
+
+      // Saturated onto the null value
+      io::assert(output[2].has_value() == false);
+      io::assert(*output[3] == std::numeric_limits<std::int32_t>::min());
+      io::assert(*output[4] == -7);
+      io::assert(report == io::conversion_report{ 2, 1 });
+
+      bool thrown = false;
+      try
+      {
+         (void)io::convert_column<io::overflow_policy::checked>(input, output);
+      }
+      catch (const io::conversion_overflow&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+
+      // In range, with the source sentinel mapped to the destination sentinel. The converting
+      // constructor would keep -1 as a value.
+      const std::vector<opt_i64> valid{ opt_i64{ 1 }, opt_i64{}, opt_i64{ 3 } };
+      std::vector<opt_i32> valid_output(valid.size());
+      io::assert(io::convert_column<io::overflow_policy::checked>(valid, valid_output) == io::conversion_report{});
+      for (std::size_t i = 0; i < valid.size(); ++i)
+      {
+         io::assert(valid_output[i] == (valid[i].has_value() ? opt_i32(static_cast<std::int32_t>(*valid[i])) : opt_i32{}));
+      }
+   }
+
+
+   auto test_collisions() -> void
+   {
+      // 0 is a value in the source but the sentinel of the destination
+      const std::vector<opt_i32> input{ opt_i32{ 0 }, opt_i32{ 5 }, opt_i32{}, opt_i32{ -3 } };
+      std::vector<opt_u8> output(input.size());
+      const io::conversion_report report = io::convert_column(input, output);
+      io::assert(output[0].has_value() == false);
+      io::assert(*output[1] == 5);
+      io::assert(output[2].has_value() == false);
+      io::assert(output[3].has_value() == false);
+      io::assert(report == io::conversion_report{ 1, 2 });
+   }
+
+
+   auto test_floating() -> void
+   {
+      const std::vector<opt_double> input{ opt_double{ 1.5 }, opt_double{}, opt_double{ 1e300 }, opt_double{ -1.0 } };
+      std::vector<opt_float> floats(input.size());
+      const io::conversion_report report = io::convert_column(input, floats);
+      io::assert(*floats[0] == 1.5f);
+      io::assert(floats[1].has_value() == false);
+      io::assert(*floats[2] == std::numeric_limits<float>::max());
+      io::assert(floats[3].has_value() == false);
+      io::assert(report == io::conversion_report{ 1, 1 });
+
+      // Widening back, nulls become NaN sentinels
+      std::vector<opt_double> doubles(floats.size());
+      io::assert(io::convert_column<io::overflow_policy::checked>(floats, doubles) == io::conversion_report{});
+      io::assert(*doubles[0] == 1.5);
+      io::assert(doubles[1].has_value() == false);
+      io::assert(std::isnan(*doubles[1]));
+      io::assert(doubles[3].has_value() == false);
+
+      // A NaN that isn't the sentinel is a value, but out of range for integers
+      std::vector<opt_double> nan_input{ opt_double{ 2.0 } };
+      *nan_input[0] = -std::numeric_limits<double>::quiet_NaN();
+      io::assert(nan_input[0].has_value());
+      std::vector<opt_i32> integers(1);
+      io::assert(io::convert_column(nan_input, integers) == io::conversion_report{ 1, 1 });
+      io::assert(integers[0].has_value() == false);
+   }
+
+
+   auto test_size_mismatch() -> void
+   {
+      const std::vector<opt_i64> input(3);
+      std::vector<opt_i32> output(2);
+      bool thrown = false;
+      try
+      {
+         (void)io::convert_column(input, output);
+      }
+      catch (const std::length_error&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+} // namespace {}
+
+
+auto io::test_convert() -> void
+{
+   test_narrowing();
+   test_collisions();
+   test_floating();
+   test_size_mismatch();
+}
@@ -0,0 +1,233 @@
+// The checks of safety_mode_t::debug are tested regardless of how the tests are built. All debug
+// mode types here use a local failure policy, so no other translation unit sees them with another
+// IO_DEBUG_CHECKS.
+#define IO_DEBUG_CHECKS 1
+
+#include "test_debug.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_by_member.h"
+#include "../intrusive_optional_codecs.h"
+#include "../intrusive_optional_expressions.h"
+#include "../intrusive_optional_join.h"
+#include "../intrusive_optional_views.h"
+
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace
+{
+
+   struct debug_failure
+   {
+      io::optional_errc error;
+   };
+
+   struct throw_debug_failure
+   {
+      [[noreturn]] static auto fail(const io::optional_errc error) -> void
+      {
+         throw debug_failure{ error };
+      }
+   };
+
+   template <typename lambda>
+   [[nodiscard]] auto debug_error(const lambda& fun) -> io::optional_errc
+   {
+      try
+      {
+         fun();
+      }
+      catch (const debug_failure& failure)
+      {
+         return failure.error;
+      }
+      return io::optional_errc::none;
+   }
+
+
+   using debug_type = io::intrusive_optional<-7, io::safety_mode_t::debug, io::no_telemetry, throw_debug_failure>;
+   using unsafe_type = io::intrusive_optional<-7, io::safety_mode_t::unsafe, io::no_telemetry, throw_debug_failure>;
+   using safe_type = io::intrusive_optional<-7, io::safety_mode_t::safe, io::no_telemetry, throw_debug_failure>;
+
+   // The API of unsafe mode, including the mutable accessors that safe mode doesn't have
+   template <typename T>
+   concept has_mutable_access = requires(T& opt) {
+      { *opt } -> std::same_as<typename T::value_type&>;
+      { *std::move(opt) } -> std::same_as<typename T::value_type&&>;
+      { opt.value() } -> std::same_as<typename T::value_type&>;
+      opt.try_value();
+   };
+   static_assert(has_mutable_access<debug_type>);
+   static_assert(has_mutable_access<unsafe_type>);
+   static_assert(has_mutable_access<safe_type> == false);
+
+   // The checks can throw with this policy, only the unchecked members stay noexcept
+   static_assert(noexcept(*std::declval<unsafe_type&>()));
+   static_assert(noexcept(*std::declval<debug_type&>()) == false);
+   static_assert(noexcept(std::declval<const debug_type&>().operator->()) == false);
+   static_assert(noexcept(std::declval<debug_type&>().has_value()));
+   static_assert(sizeof(debug_type) == sizeof(int));
+   static_assert(std::is_trivially_copyable_v<debug_type>);
+
+   constexpr debug_type constexpr_value = 4;
+   static_assert(*constexpr_value == 4);
+
+   // Columns of every mode and policy are columns
+   static_assert(io::optional_column<std::vector<debug_type>&>);
+   static_assert(io::mutable_optional_column<std::vector<safe_type>&>);
+
+
+   struct record
+   {
+      int id = 0;
+      int payload = 0;
+   };
+
+   using debug_record = io::intrusive_optional_by_member<&record::id, -7, io::safety_mode_t::debug, throw_debug_failure>;
+   using safe_record = io::intrusive_optional_by_member<&record::id, -7, io::safety_mode_t::safe, throw_debug_failure>;
+
+   template <typename T>
+   concept has_mutable_record_access = requires(T& opt) {
+      { *opt } -> std::same_as<record&>;
+      { opt.operator->() } -> std::same_as<record*>;
+      { opt.value() } -> std::same_as<record&>;
+   };
+   static_assert(has_mutable_record_access<debug_record>);
+   static_assert(has_mutable_record_access<safe_record> == false);
+
+
+   auto test_access() -> void
+   {
+      debug_type value = 3;
+      *value = 5;
+      io::assert(*value == 5);
+      io::assert(*std::as_const(value) == 5);
+      io::assert(value.operator->() == &*value);
+
+      debug_type null;
+      io::assert(debug_error([&] { [[maybe_unused]] int& i = *null; }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { [[maybe_unused]] const int& i = *std::as_const(null); }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { [[maybe_unused]] int&& i = *std::move(null); }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { [[maybe_unused]] const int* i = null.operator->(); }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { [[maybe_unused]] int& i = null.value(); }) == io::optional_errc::bad_access);
+
+      // Unsafe mode doesn't check
+      unsafe_type unsafe_null;
+      io::assert(*unsafe_null == -7);
+   }
+
+
+   auto test_null_checks() -> void
+   {
+      io::assert(debug_error([] { debug_type opt(-7); }) == io::optional_errc::unintentionally_null);
+      io::assert(debug_error([] { debug_type opt; opt.emplace(-7); }) == io::optional_errc::unintentionally_null);
+      io::assert(debug_error([] { debug_type opt = 1; opt = -7; }) == io::optional_errc::unintentionally_null);
+      io::assert(debug_error([] { debug_type opt = 1; opt.modify([](int& i) { i = -7; }); }) == io::optional_errc::unintentionally_null);
+      io::assert(debug_error([] { debug_type opt; opt.reset(); opt = std::nullopt; }) == io::optional_errc::none);
+   }
+
+
+   // Nulls are copied, compared, hashed and mapped without tripping the access checks
+   auto test_nulls_pass_through() -> void
+   {
+      const debug_type null;
+      const debug_type value = 2;
+      io::assert(debug_error([&]
+      {
+         debug_type copy = null;
+         copy = null;
+         copy = value;
+         copy = null;
+         debug_type moved = std::move(copy);
+         moved.swap(copy);
+         io::assert(copy.has_value() == false);
+         io::assert(null == copy);
+         io::assert(null != value);
+         io::assert(null < value);
+         io::assert((null <=> value) < 0);
+         io::assert((null == 2) == false);
+         io::assert(std::hash<debug_type>{}(null) == 0);
+         io::assert(null.value_or(1) == 1);
+         io::assert(null.transform([](const int i) { return i + 1; }).has_value() == false);
+         io::assert(value.transform([](const int i) { return i + 1; }) == 3);
+         io::assert(null.and_then([](const int i) { return debug_type(i); }).has_value() == false);
+         io::assert(null.try_value().error() == io::optional_errc::bad_access);
+      }) == io::optional_errc::none);
+   }
+
+
+   auto test_by_member() -> void
+   {
+      debug_record value(record{ 1, 2 });
+      value->payload = 3;
+      (*value).payload += 1;
+      io::assert(value.value().payload == 4);
+
+      io::assert(debug_error([] { debug_record opt(record{ -7, 0 }); }) == io::optional_errc::unintentionally_null);
+      io::assert(debug_error([] { debug_record opt; opt.emplace(-7, 0); }) == io::optional_errc::unintentionally_null);
+      io::assert(debug_error([] { debug_record opt; opt = record{ -7, 1 }; }) == io::optional_errc::unintentionally_null);
+
+      debug_record null;
+      io::assert(debug_error([&] { [[maybe_unused]] record& r = *null; }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { [[maybe_unused]] const record* r = std::as_const(null).operator->(); }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { [[maybe_unused]] record& r = null.value(); }) == io::optional_errc::bad_access);
+      io::assert(debug_error([&] { null.reset(); io::assert(null == std::nullopt); }) == io::optional_errc::none);
+   }
+
+
+   // The kernels read and write null elements without tripping the access checks
+   auto test_column_kernels() -> void
+   {
+      io::assert(debug_error([]
+      {
+         std::vector<debug_type> column{ 1, debug_type{}, 3, debug_type{} };
+         io::assert(io::count_null(column) == 2);
+
+         int sum = 0;
+         for (const int value : column | io::views::engaged)
+         {
+            sum += value;
+         }
+         io::assert(sum == 4);
+         io::assert(*(column | io::views::values_or(0)).begin() == 1);
+
+         std::vector<debug_type> doubled(column.size());
+         io::evaluate(io::col(column) + io::col(column), doubled);
+         io::assert(doubled[2] == 6);
+         io::assert(doubled[3].has_value() == false);
+
+         const io::join_result joined = io::inner_join(column, column);
+         io::assert(joined.left_rows.size() == 2);
+
+         std::vector<debug_type> decoded(column.size());
+         io::decode_null_runs(io::encode_null_runs(column), decoded);
+         io::assert(decoded == column);
+
+         io::forward_fill(column);
+         io::assert(column[1] == 1);
+         io::assert(column[3] == 3);
+
+         // Safe columns too, their values never collide with the sentinel in a fill
+         std::vector<safe_type> safe_column{ safe_type{}, 2, safe_type{} };
+         io::backward_fill(safe_column);
+         io::assert(safe_column[0] == 2);
+         io::assert(safe_column[2].has_value() == false);
+         io::assert(io::count_null(safe_column) == 1);
+      }) == io::optional_errc::none);
+   }
+
+} // namespace {}
+
+
+auto io::test_debug() -> void
+{
+   test_access();
+   test_null_checks();
+   test_nulls_pass_through();
+   test_by_member();
+   test_column_kernels();
+}
@@ -0,0 +1,165 @@
+#include "test_expressions.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_expressions.h"
+
+#include <limits>
+
+
+namespace
+{
+
+   using int_opt = io::intrusive_optional<-1>;
+   using double_opt = io::intrusive_optional<std::numeric_limits<double>::max()>;
+
+   auto make_column(const std::vector<int>& values) -> std::vector<int_opt>
+   {
+      std::vector<int_opt> result(values.size());
+      for (std::size_t i = 0; i < values.size(); ++i)
+      {
+         if (values[i] != -1)
+            result[i].emplace(values[i]);
+      }
+      return result;
+   }
+
+
+   auto test_null_propagation()-> void
+   {
+      const std::vector<int_opt> a = make_column({ 1, 2, -1, 4, 5 });
+      const std::vector<int_opt> b = make_column({ 2, -1, 3, 4, 5 });
+      const std::vector<int_opt> c = make_column({ 1, 1, 1, -1, 1 });
+      std::vector<double_opt> result(a.size());
+      io::evaluate(io::col(a) * io::col(b) + io::col(c), result);
+
+      io::assert(*result[0] == 3.0);
+      io::assert(result[1].has_value() == false);
+      io::assert(result[2].has_value() == false);
+      io::assert(result[3].has_value() == false);
+      io::assert(*result[4] == 26.0);
+   }
+
+
+   auto test_scalars()-> void
+   {
+      const std::vector<int_opt> a = make_column({ 4, -1, 8 });
+      std::vector<int_opt> result(a.size());
+      io::evaluate(2 * io::col(a) - 1, result);
+      io::assert(*result[0] == 7);
+      io::assert(result[1].has_value() == false);
+      io::assert(*result[2] == 15);
+   }
+
+
+   auto test_division()-> void
+   {
+      // A null divisor must not be used in the division
+      const std::vector<int_opt> a = make_column({ 4, 6, 8 });
+      const std::vector<int_opt> b = make_column({ 2, -1, 4 });
+      std::vector<int_opt> result(a.size());
+      io::evaluate(io::col(a) / io::col(b), result);
+      io::assert(*result[0] == 2);
+      io::assert(result[1].has_value() == false);
+      io::assert(*result[2] == 2);
+   }
+
+
+   auto test_undefined_division()-> void
+   {
+      // Integer division by zero and INT_MIN / -1 are null instead of undefined
+      using max_opt = io::intrusive_optional<std::numeric_limits<int>::max()>;
+      const std::vector<max_opt> a = { 4, std::numeric_limits<int>::min(), std::numeric_limits<int>::min(), 9 };
+      const std::vector<max_opt> b = { 0, -1, 2, -3 };
+      std::vector<max_opt> result(a.size());
+      io::evaluate(io::col(a) / io::col(b), result);
+      io::assert(result[0].has_value() == false);
+      io::assert(result[1].has_value() == false);
+      io::assert(*result[2] == std::numeric_limits<int>::min() / 2);
+      io::assert(*result[3] == -3);
+
+      io::evaluate(io::col(a) / 0, result);
+      io::assert(io::count_null(result) == result.size());
+
+      // Floating-point division stays IEEE
+      std::vector<double_opt> doubles(a.size());
+      io::evaluate(1.0 / io::col(b), doubles);
+      io::assert(*doubles[0] == std::numeric_limits<double>::infinity());
+   }
+
+
+   auto test_nan_sentinel()-> void
+   {
+      using nan_opt = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+      const std::vector<nan_opt> a = { 1.0, nan_opt{}, 3.0 };
+      const std::vector<nan_opt> b = { 2.0, 2.0, nan_opt{} };
+      std::vector<double_opt> result(a.size());
+      io::evaluate(io::col(a) * io::col(b) + 1.0, result);
+      io::assert(*result[0] == 3.0);
+      io::assert(result[1].has_value() == false);
+      io::assert(result[2].has_value() == false);
+   }
+
+
+   // Leaf that counts its evaluations
+   struct counting_leaf
+   {
+      using is_column_expression = void;
+
+      std::size_t* m_count;
+
+      [[nodiscard]] auto size() const -> std::size_t
+      {
+         return 1;
+      }
+
+      [[nodiscard]] auto eval(std::size_t) const -> io::expression_value<double>
+      {
+         ++*m_count;
+         return { 2.0, true };
+      }
+   };
+
+
+   // Nested divisions evaluate every leaf once per element
+   auto test_single_evaluation()-> void
+   {
+      using io::operator/;
+      std::size_t count = 0;
+      const counting_leaf leaf{ &count };
+      const auto expression = ((leaf / leaf) / (leaf / leaf)) / ((leaf / leaf) / (leaf / leaf));
+      std::vector<double_opt> out(1);
+      io::evaluate(expression, out);
+      io::assert(count == 8);
+      io::assert(out[0] == 1.0);
+   }
+
+
+   auto test_size_mismatch()-> void
+   {
+      const std::vector<int_opt> a = make_column({ 1, 2 });
+      const std::vector<int_opt> b = make_column({ 1, 2, 3 });
+      bool has_thrown = false;
+      try
+      {
+         [[maybe_unused]] const auto expression = io::col(a) + io::col(b);
+      }
+      catch (const io::expression_size_mismatch&)
+      {
+         has_thrown = true;
+      }
+      io::assert(has_thrown);
+   }
+   
+} // namespace {}
+
+
+auto io::test_expressions() -> void
+{
+   test_null_propagation();
+   test_scalars();
+   test_division();
+   test_undefined_division();
+   test_nan_sentinel();
+   test_single_evaluation();
+   test_size_mismatch();
+}
@@ -0,0 +1,174 @@
+#include "test_failure.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_by_member.h"
+#include "../intrusive_optional_failure.h"
+#include "../intrusive_optional_gapped_array.h"
+#include "../intrusive_optional_slot_map.h"
+
+#include <optional>
+#include <type_traits>
+
+
+namespace
+{
+
+   // Failure policy that reports the error as an exception, so the routing can be tested
+   struct routed_failure
+   {
+      io::optional_errc error;
+   };
+
+   struct throw_routed_failure
+   {
+      [[noreturn]] static auto fail(const io::optional_errc error) -> void
+      {
+         throw routed_failure{ error };
+      }
+   };
+
+   template <typename opt_type, typename lambda>
+   [[nodiscard]] auto routed_error(const lambda& fun) -> io::optional_errc
+   {
+      try
+      {
+         fun();
+      }
+      catch (const routed_failure& failure)
+      {
+         return failure.error;
+      }
+      return io::optional_errc::none;
+   }
+
+
+   using opt_type = io::intrusive_optional<-1>;
+   using safe_abort_type = io::intrusive_optional<-1, io::safety_mode_t::safe, io::no_telemetry, io::abort_on_failure>;
+   using safe_throw_type = io::intrusive_optional<-1, io::safety_mode_t::safe>;
+
+   // Checks that can't throw make the checked members noexcept
+   static_assert(std::is_nothrow_constructible_v<safe_abort_type, int>);
+   static_assert(std::is_nothrow_constructible_v<safe_throw_type, int> == false);
+   static_assert(noexcept(std::declval<safe_abort_type&>().emplace(1)));
+   static_assert(noexcept(std::declval<safe_throw_type&>().emplace(1)) == false);
+   static_assert(sizeof(safe_abort_type) == sizeof(int));
+
+   constexpr opt_type constexpr_value = 4;
+   constexpr opt_type constexpr_null;
+   static_assert(constexpr_value.try_value().has_value());
+   static_assert(*constexpr_value.try_value() == 4);
+   static_assert(constexpr_null.try_value().error() == io::optional_errc::bad_access);
+
+   // try_value() of temporaries would dangle
+   template <typename T>
+   concept has_try_value = requires { std::declval<T>().try_value(); };
+   static_assert(has_try_value<opt_type&>);
+   static_assert(has_try_value<opt_type> == false);
+
+
+   auto test_try_value() -> void
+   {
+      opt_type value = 3;
+      io::value_result<int> result = value.try_value();
+      io::assert(bool(result));
+      io::assert(result.error() == io::optional_errc::none);
+      *result = 4;
+      io::assert(value == 4);
+
+      const opt_type null;
+      const io::value_result<const int> null_result = null.try_value();
+      io::assert(null_result.has_value() == false);
+      io::assert(null_result.error() == io::optional_errc::bad_access);
+
+      // Safe mode only hands out const references
+      const safe_throw_type safe = 2;
+      io::assert(*safe.try_value() == 2);
+   }
+
+
+   auto test_try_emplace() -> void
+   {
+      opt_type value;
+      io::assert(value.try_emplace(5) == io::optional_errc::none);
+      io::assert(value == 5);
+      io::assert(value.try_emplace(-1) == io::optional_errc::unintentionally_null);
+      io::assert(value.has_value() == false);
+
+      // Also in safe mode, without failing
+      safe_throw_type safe;
+      io::assert(safe.try_emplace(-1) == io::optional_errc::unintentionally_null);
+      io::assert(safe.try_emplace(7) == io::optional_errc::none);
+      io::assert(safe == 7);
+   }
+
+
+   auto test_routing() -> void
+   {
+      using routed_type = io::intrusive_optional<-1, io::safety_mode_t::safe, io::no_telemetry, throw_routed_failure>;
+      io::assert(routed_error<routed_type>([]() { [[maybe_unused]] const int i = routed_type().value(); })
+         == io::optional_errc::bad_access);
+      io::assert(routed_error<routed_type>([]() { routed_type value(-1); })
+         == io::optional_errc::unintentionally_null);
+      io::assert(routed_error<routed_type>([]() { routed_type value; value.emplace(-1); })
+         == io::optional_errc::unintentionally_null);
+      io::assert(routed_error<routed_type>([]() { routed_type value; value.modify([](int& i) { i = 1; }); })
+         == io::optional_errc::bad_access);
+      io::assert(routed_error<routed_type>([]() { routed_type value(3); [[maybe_unused]] const int i = value.value(); })
+         == io::optional_errc::none);
+
+      // The default policy still throws the standard exceptions
+      bool thrown = false;
+      try
+      {
+         [[maybe_unused]] const int i = opt_type().value();
+      }
+      catch (const std::bad_optional_access&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+
+   auto test_companion_routing() -> void
+   {
+      struct record
+      {
+         int id = 0;
+      };
+      using by_member_type = io::intrusive_optional_by_member<&record::id, -1, io::safety_mode_t::safe, throw_routed_failure>;
+      io::assert(routed_error<by_member_type>([]() { [[maybe_unused]] const record r = by_member_type().value(); })
+         == io::optional_errc::bad_access);
+      io::assert(routed_error<by_member_type>([]() { by_member_type value(record{ -1 }); })
+         == io::optional_errc::unintentionally_null);
+
+      using slot_map_type = io::slot_map<-1, throw_routed_failure>;
+      io::assert(routed_error<slot_map_type>([]() { slot_map_type slots; slots.insert(-1); })
+         == io::optional_errc::unintentionally_null);
+      io::assert(routed_error<slot_map_type>([]() { slot_map_type slots; slots.erase(slots.insert(1)); slots.insert(-1); })
+         == io::optional_errc::unintentionally_null);
+
+      using sorted_type = io::gapped_sorted_array<-1, 32, throw_routed_failure>;
+      io::assert(routed_error<sorted_type>([]() { sorted_type sorted; sorted.insert(-1); })
+         == io::optional_errc::unintentionally_null);
+   }
+
+
+   auto test_callback() -> void
+   {
+      const auto callback = [](io::optional_errc) {};
+      io::assert(io::set_failure_callback(callback) == nullptr);
+      io::assert(io::set_failure_callback(nullptr) == callback);
+   }
+
+} // namespace {}
+
+
+auto io::test_failure() -> void
+{
+   test_try_value();
+   test_try_emplace();
+   test_routing();
+   test_companion_routing();
+   test_callback();
+}
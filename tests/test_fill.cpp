@@ -0,0 +1,201 @@
+#include "test_fill.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_algorithms.h"
+
+#include <limits>
+
+
+namespace
+{
+
+   constexpr double null = std::numeric_limits<double>::max();
+   using opt_type = io::intrusive_optional<null>;
+
+   auto make_column(const std::vector<double>& values) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(values.size());
+      for (std::size_t i = 0; i < values.size(); ++i)
+      {
+         if (values[i] != null)
+            result[i].emplace(values[i]);
+      }
+      return result;
+   }
+
+
+   auto test_forward_fill()-> void
+   {
+      {
+         std::vector<opt_type> column = make_column({ null, 1.0, null, null, 4.0, null });
+         io::forward_fill(column);
+         io::assert(column == make_column({ null, 1.0, 1.0, 1.0, 4.0, 4.0 }));
+      }
+      {
+         std::vector<opt_type> column = make_column({ 1.0, null, null, null, 4.0, null });
+         io::forward_fill(column, 2);
+         io::assert(column == make_column({ 1.0, 1.0, 1.0, null, 4.0, 4.0 }));
+      }
+   }
+
+
+   auto test_backward_fill()-> void
+   {
+      {
+         std::vector<opt_type> column = make_column({ null, 1.0, null, null, 4.0, null });
+         io::backward_fill(column);
+         io::assert(column == make_column({ 1.0, 1.0, 4.0, 4.0, 4.0, null }));
+      }
+      {
+         std::vector<opt_type> column = make_column({ 1.0, null, null, null, 4.0, null });
+         io::backward_fill(column, 1);
+         io::assert(column == make_column({ 1.0, null, null, 4.0, 4.0, null }));
+      }
+   }
+
+
+   auto test_interpolate()-> void
+   {
+      std::vector<opt_type> column = make_column({ null, 1.0, null, null, 4.0, null });
+      io::interpolate_linear(column);
+      io::assert(column == make_column({ null, 1.0, 2.0, 3.0, 4.0, null }));
+   }
+
+
+   auto test_interpolate_integers()-> void
+   {
+      // The sentinel -1 lies in the gap between -2 and 0. It's moved towards -2.
+      using int_opt = io::intrusive_optional<-1>;
+      std::vector<int_opt> column = { -2, int_opt{}, 0, int_opt{}, int_opt{}, 3, int_opt{}, -3 };
+      io::interpolate_linear(column);
+      io::assert(io::count_null(column) == 0);
+      io::assert(column == std::vector<int_opt>{ -2, -2, 0, 1, 2, 3, 0, -3 });
+
+      // Exact at the limits of 64-bit integers, where doubles lose precision
+      using int64_opt = io::intrusive_optional<std::int64_t{ 0 }>;
+      constexpr std::int64_t min = std::numeric_limits<std::int64_t>::min();
+      constexpr std::int64_t max = std::numeric_limits<std::int64_t>::max();
+      std::vector<int64_opt> wide = { max - 2, int64_opt{}, max, int64_opt{}, min };
+      io::interpolate_linear(wide);
+      io::assert(*wide[1] == max - 1);
+      io::assert(*wide[3] == -1);
+
+      // 1 and -1 around the sentinel 0 interpolate to it, and move towards the first value
+      std::vector<int64_opt> around = { 1, int64_opt{}, -1 };
+      io::interpolate_linear(around);
+      io::assert(*around[1] == 1);
+   }
+
+
+   auto test_parallel()-> void
+   {
+      std::vector<double> values(1000, null);
+      values[3] = 3.0;
+      values[500] = 500.0;
+      values[501] = 501.0;
+      values[990] = 990.0;
+      for (const std::size_t thread_count : { 1, 3, 7, 64 })
+      {
+         std::vector<opt_type> expected = make_column(values);
+         std::vector<opt_type> column = expected;
+         io::forward_fill(expected);
+         io::parallel_forward_fill(column, thread_count);
+         io::assert(column == expected);
+
+         expected = make_column(values);
+         column = expected;
+         io::backward_fill(expected);
+         io::parallel_backward_fill(column, thread_count);
+         io::assert(column == expected);
+
+         expected = make_column(values);
+         column = expected;
+         io::interpolate_linear(expected);
+         io::parallel_interpolate_linear(column, thread_count);
+         io::assert(column == expected);
+
+         for (const std::size_t limit : { 0, 1, 2, 5, 200, 600 })
+         {
+            expected = make_column(values);
+            column = expected;
+            io::forward_fill(expected, limit);
+            io::parallel_forward_fill(column, limit, thread_count);
+            io::assert(column == expected);
+
+            expected = make_column(values);
+            column = expected;
+            io::backward_fill(expected, limit);
+            io::parallel_backward_fill(column, limit, thread_count);
+            io::assert(column == expected);
+         }
+      }
+   }
+
+
+   auto test_nan_sentinel()-> void
+   {
+      using nan_opt = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+      const std::vector<nan_opt> original = { nan_opt{}, 1.0, nan_opt{}, nan_opt{}, 4.0, nan_opt{} };
+      const auto values = [](const std::vector<nan_opt>& column)
+      {
+         std::vector<double> result;
+         for (const nan_opt& opt : column)
+         {
+            result.push_back(opt.value_or(-1.0));
+         }
+         return result;
+      };
+
+      std::vector<nan_opt> column = original;
+      io::forward_fill(column);
+      io::assert((values(column) == std::vector<double>{ -1.0, 1.0, 1.0, 1.0, 4.0, 4.0 }));
+
+      column = original;
+      io::forward_fill(column, 1);
+      io::assert((values(column) == std::vector<double>{ -1.0, 1.0, 1.0, -1.0, 4.0, 4.0 }));
+
+      column = original;
+      io::backward_fill(column);
+      io::assert((values(column) == std::vector<double>{ 1.0, 1.0, 4.0, 4.0, 4.0, -1.0 }));
+
+      column = original;
+      io::backward_fill(column, 1);
+      io::assert((values(column) == std::vector<double>{ 1.0, 1.0, -1.0, 4.0, 4.0, -1.0 }));
+
+      column = original;
+      io::parallel_forward_fill(column, 3);
+      io::assert((values(column) == std::vector<double>{ -1.0, 1.0, 1.0, 1.0, 4.0, 4.0 }));
+
+      column = original;
+      io::parallel_backward_fill(column, 3);
+      io::assert((values(column) == std::vector<double>{ 1.0, 1.0, 4.0, 4.0, 4.0, -1.0 }));
+
+      column = original;
+      io::interpolate_linear(column);
+      io::assert((values(column) == std::vector<double>{ -1.0, 1.0, 2.0, 3.0, 4.0, -1.0 }));
+
+      column = original;
+      io::parallel_interpolate_linear(column, 3);
+      io::assert((values(column) == std::vector<double>{ -1.0, 1.0, 2.0, 3.0, 4.0, -1.0 }));
+
+      column = original;
+      io::parallel_forward_fill(column, 1, 3);
+      io::assert((values(column) == std::vector<double>{ -1.0, 1.0, 1.0, -1.0, 4.0, 4.0 }));
+
+      column = original;
+      io::parallel_backward_fill(column, 1, 3);
+      io::assert((values(column) == std::vector<double>{ 1.0, 1.0, -1.0, 4.0, 4.0, -1.0 }));
+   }
+   
+} // namespace {}
+
+
+auto io::test_fill() -> void
+{
+   test_forward_fill();
+   test_backward_fill();
+   test_interpolate();
+   test_interpolate_integers();
+   test_parallel();
+   test_nan_sentinel();
+}
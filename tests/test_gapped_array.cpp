@@ -0,0 +1,124 @@
+#include "test_gapped_array.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_gapped_array.h"
+
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <set>
+
+
+namespace
+{
+
+   using array_type = io::gapped_sorted_array<std::uint64_t{ 0 }, 8>;
+
+   auto to_vector(const array_type& array) -> std::vector<std::uint64_t>
+   {
+      std::vector<std::uint64_t> result;
+      for (const std::uint64_t value : array.values())
+      {
+         result.push_back(value);
+      }
+      return result;
+   }
+
+
+   auto test_against_set()-> void
+   {
+      array_type array;
+      std::set<std::uint64_t> reference;
+      std::mt19937 generator(42);
+      for (int i = 0; i < 5000; ++i)
+      {
+         const std::uint64_t value = generator() % 2000 + 1;
+         if (generator() % 3 == 0)
+            io::assert(array.erase(value) == (reference.erase(value) == 1));
+         else
+            io::assert(array.insert(value) == reference.insert(value).second);
+      }
+      io::assert(array.size() == reference.size());
+      io::assert(to_vector(array) == std::vector<std::uint64_t>(reference.begin(), reference.end()));
+      for (std::uint64_t value = 1; value <= 2000; ++value)
+      {
+         io::assert(array.contains(value) == reference.contains(value));
+      }
+
+      // Erasing most values shrinks the array again
+      const std::size_t capacity = array.capacity();
+      for (std::uint64_t value = 1; value <= 1900; ++value)
+      {
+         array.erase(value);
+         reference.erase(value);
+      }
+      io::assert(array.capacity() < capacity);
+      io::assert(to_vector(array) == std::vector<std::uint64_t>(reference.begin(), reference.end()));
+   }
+
+
+   auto test_sequential_inserts()-> void
+   {
+      // Ascending and descending inserts always hit the same segment
+      array_type ascending;
+      array_type descending;
+      for (std::uint64_t value = 1; value <= 1000; ++value)
+      {
+         ascending.insert(value);
+         descending.insert(1001 - value);
+      }
+      io::assert(to_vector(ascending) == to_vector(descending));
+      io::assert(std::ranges::is_sorted(to_vector(ascending)));
+      io::assert(ascending.size() == 1000);
+      io::assert(ascending.capacity() >= 1000 && ascending.capacity() <= 4 * 1000);
+
+      const std::uint64_t max = std::numeric_limits<std::uint64_t>::max();
+      ascending.insert(max);
+      io::assert(ascending.contains(max));
+      io::assert(ascending.erase(max));
+   }
+
+
+   auto test_scan()-> void
+   {
+      array_type array;
+      for (std::uint64_t value = 10; value <= 1000; value += 10)
+      {
+         array.insert(value);
+      }
+      std::vector<std::uint64_t> scanned;
+      array.scan(95, 150, [&](const std::uint64_t value) { scanned.push_back(value); });
+      io::assert((scanned == std::vector<std::uint64_t>{ 100, 110, 120, 130, 140, 150 }));
+
+      scanned.clear();
+      array.scan(1001, 2000, [&](const std::uint64_t value) { scanned.push_back(value); });
+      io::assert(scanned.empty());
+   }
+
+
+   auto test_null_insert()-> void
+   {
+      array_type array;
+      bool thrown = false;
+      try
+      {
+         array.insert(0);
+      }
+      catch (const io::unintentionally_null&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+      io::assert(array.empty());
+   }
+
+} // namespace {}
+
+
+auto io::test_gapped_array() -> void
+{
+   test_against_set();
+   test_sequential_inserts();
+   test_scan();
+   test_null_insert();
+}
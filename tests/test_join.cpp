@@ -0,0 +1,160 @@
+#include "test_join.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_join.h"
+
+#include <limits>
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<-1>;
+
+   auto make_column(const std::vector<int>& values) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(values.size());
+      for (std::size_t i = 0; i < values.size(); ++i)
+      {
+         if (values[i] != -1)
+            result[i].emplace(values[i]);
+      }
+      return result;
+   }
+
+
+   auto test_hash_column()-> void
+   {
+      const std::vector<opt_type> column = make_column({ 1, -1, 1, 2 });
+      std::vector<std::uint64_t> hashes(column.size());
+      io::hash_column(column, hashes);
+      io::assert(hashes[0] == hashes[2]);
+      io::assert(hashes[0] != hashes[3]);
+      io::assert(hashes[1] == io::null_key_hash);
+   }
+
+
+   auto test_group_by()-> void
+   {
+      const std::vector<opt_type> column = make_column({ 5, -1, 7, 5, -1, 7, 8 });
+      {
+         const io::group_result groups = io::group_by(column, io::null_key_policy::drop);
+         io::assert(groups.group_count == 3);
+         io::assert(*groups.group_ids[0] == 0 && *groups.group_ids[3] == 0);
+         io::assert(*groups.group_ids[2] == 1 && *groups.group_ids[5] == 1);
+         io::assert(*groups.group_ids[6] == 2);
+         io::assert(groups.group_ids[1].has_value() == false);
+      }
+      {
+         const io::group_result groups = io::group_by(column, io::null_key_policy::group);
+         io::assert(groups.group_count == 4);
+         io::assert(*groups.group_ids[1] == 1 && *groups.group_ids[4] == 1);
+      }
+      {
+         const io::group_result groups = io::group_by(column, io::null_key_policy::distinct);
+         io::assert(groups.group_count == 5);
+         io::assert(*groups.group_ids[1] != *groups.group_ids[4]);
+      }
+   }
+
+
+   auto test_joins()-> void
+   {
+      const std::vector<opt_type> left = make_column({ 1, 2, -1, 3 });
+      const std::vector<opt_type> right = make_column({ 3, -1, 1, 1 });
+      {
+         const io::join_result result = io::inner_join(left, right);
+         io::assert((result.left_rows == std::vector<std::size_t>{0, 0, 3}));
+         io::assert(*result.right_rows[0] == 2 && *result.right_rows[1] == 3 && *result.right_rows[2] == 0);
+      }
+      {
+         const io::join_result result = io::inner_join(left, right, io::null_key_policy::group);
+         io::assert((result.left_rows == std::vector<std::size_t>{0, 0, 2, 3}));
+         io::assert(*result.right_rows[2] == 1);
+      }
+      {
+         const io::join_result result = io::left_join(left, right);
+         io::assert((result.left_rows == std::vector<std::size_t>{0, 0, 1, 2, 3}));
+         io::assert(result.right_rows[2].has_value() == false);
+         io::assert(result.right_rows[3].has_value() == false);
+
+         // Payload of the right side. Unmatched rows come out as sentinel.
+         const std::vector<opt_type> payload = make_column({ 30, 40, 10, 11 });
+         std::vector<opt_type> gathered(result.right_rows.size());
+         io::gather(payload, result.right_rows, gathered);
+         io::assert(gathered == make_column({ 10, 11, -1, -1, 30 }));
+      }
+      {
+         const io::join_result result = io::left_join(left, right, io::null_key_policy::drop);
+         io::assert((result.left_rows == std::vector<std::size_t>{0, 0, 1, 3}));
+      }
+   }
+
+
+   // The raw sentinel of one side is an ordinary key on the other side
+   auto test_different_sentinels()-> void
+   {
+      using zero_opt = io::intrusive_optional<0>;
+      const std::vector<opt_type> left = make_column({ -1, 0, 5 });
+      const std::vector<zero_opt> right = { zero_opt{}, zero_opt{ -1 }, zero_opt{ 5 } };
+      {
+         const io::join_result result = io::inner_join(left, right, io::null_key_policy::group);
+         io::assert((result.left_rows == std::vector<std::size_t>{0, 2}));
+         io::assert(*result.right_rows[0] == 0 && *result.right_rows[1] == 2);
+      }
+      {
+         const io::join_result result = io::inner_join(left, right, io::null_key_policy::distinct);
+         io::assert((result.left_rows == std::vector<std::size_t>{2}));
+      }
+      {
+         const io::join_result result = io::left_join(right, left, io::null_key_policy::group);
+         io::assert((result.left_rows == std::vector<std::size_t>{0, 1, 2}));
+         io::assert(*result.right_rows[0] == 0);
+         io::assert(result.right_rows[1].has_value() == false);
+         io::assert(*result.right_rows[2] == 2);
+      }
+   }
+
+
+   // A null source row comes out as the sentinel of the output, not as the source sentinel
+   auto test_gather_null_rows()-> void
+   {
+      using minus_two_opt = io::intrusive_optional<-2>;
+      const std::vector<opt_type> payload = make_column({ 7, -1, 9 });
+      const std::vector<io::optional_index> rows = { io::optional_index{ std::size_t{ 1 } }, io::optional_index{}, io::optional_index{ std::size_t{ 2 } } };
+      std::vector<minus_two_opt> gathered(rows.size());
+      io::gather(payload, rows, gathered);
+      io::assert(gathered[0].has_value() == false);
+      io::assert(gathered[1].has_value() == false);
+      io::assert(gathered[2] == 9);
+   }
+
+
+   auto test_nan_sentinel()-> void
+   {
+      using nan_opt = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+      const std::vector<nan_opt> column = { 1.0, nan_opt{}, 1.0, nan_opt{} };
+      std::vector<std::uint64_t> hashes(column.size());
+      io::hash_column(column, hashes);
+      io::assert(hashes[1] == io::null_key_hash && hashes[3] == io::null_key_hash);
+
+      const io::group_result groups = io::group_by(column, io::null_key_policy::group);
+      io::assert(groups.group_count == 2);
+      io::assert(*groups.group_ids[1] == *groups.group_ids[3]);
+
+      const io::join_result result = io::inner_join(column, column, io::null_key_policy::distinct);
+      io::assert((result.left_rows == std::vector<std::size_t>{ 0, 0, 2, 2 }));
+   }
+   
+} // namespace {}
+
+
+auto io::test_join() -> void
+{
+   test_hash_column();
+   test_group_by();
+   test_joins();
+   test_different_sentinels();
+   test_gather_null_rows();
+   test_nan_sentinel();
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace io {
+   auto test_join() -> void;
+}
@@ -90,6 +90,92 @@ namespace
       }
    }
    
+
+
+   auto test_swap()-> void
+   {
+      // Trivially copyable value_type: plain exchange
+      {
+         constexpr auto swapped = []()
+         {
+            io::intrusive_optional<-1> a(5);
+            io::intrusive_optional<-1> b;
+            a.swap(b);
+            return a.has_value() == false && *b == 5;
+         };
+         static_assert(swapped());
+      }
+
+      // Non-trivial value_type: engaged/empty distinction
+      {
+         two_values_optional a(std::in_place, 1, 2);
+         two_values_optional b;
+         a.swap(b);
+         two_values_optional c(std::in_place, 3, 4);
+         b.swap(c);
+         io::assert(a.has_value() == false && *b == io::two_values(3, 4) && *c == io::two_values(1, 2));
+      }
+   }
+
+
+   struct nothrow_value
+   {
+      int a{};
+      constexpr nothrow_value() = default;
+      constexpr nothrow_value(int p) noexcept : a(p) {}
+      constexpr nothrow_value(const nothrow_value& other) noexcept : a(other.a) {}
+      constexpr auto operator=(const nothrow_value& other) noexcept -> nothrow_value& { a = other.a; return *this; }
+      constexpr ~nothrow_value() {}
+      constexpr auto operator==(const nothrow_value&) const -> bool = default;
+   };
+
+
+   auto test_special_members()-> void
+   {
+      using trivial_type = io::intrusive_optional<-1>;
+      static_assert(std::is_trivially_copyable_v<trivial_type>);
+      static_assert(std::is_trivially_destructible_v<trivial_type>);
+      static_assert(std::is_nothrow_swappable_v<trivial_type>);
+      static_assert(io::is_trivially_relocatable_v<trivial_type>);
+
+      // Non-trivial special members are noexcept if the value_type's are
+      using nothrow_type = io::intrusive_optional<nothrow_value{}>;
+      static_assert(std::is_trivially_copyable_v<nothrow_type> == false);
+      static_assert(std::is_nothrow_copy_constructible_v<nothrow_type>);
+      static_assert(std::is_nothrow_move_constructible_v<nothrow_type>);
+      static_assert(std::is_nothrow_copy_assignable_v<nothrow_type>);
+      static_assert(std::is_nothrow_move_assignable_v<nothrow_type>);
+      static_assert(std::is_nothrow_destructible_v<nothrow_type>);
+      static_assert(io::is_trivially_relocatable_v<nothrow_type> == false);
+
+      static_assert(std::is_nothrow_copy_constructible_v<io::intrusive_optional<io::one_value{}>> == false);
+      static_assert(std::is_trivially_destructible_v<io::intrusive_optional<io::one_value{}>>);
+   }
+
+
+   auto test_relocate()-> void
+   {
+      using opt_type = io::intrusive_optional<-1>;
+      opt_type source[3] = { opt_type(1), opt_type(), opt_type(3) };
+      opt_type target[3];
+      opt_type* end = io::uninitialized_relocate(source, source + 3, target);
+      io::assert(end == target + 3);
+      io::assert(*target[0] == 1 && target[1].has_value() == false && *target[2] == 3);
+
+      // Non-trivial types are moved and destroyed element-wise
+      using nothrow_type = io::intrusive_optional<nothrow_value{}>;
+      std::allocator<nothrow_type> allocator;
+      nothrow_type* nothrow_source = allocator.allocate(2);
+      nothrow_type* nothrow_target = allocator.allocate(2);
+      std::construct_at(nothrow_source, 1);
+      std::construct_at(nothrow_source + 1);
+      io::uninitialized_relocate(nothrow_source, nothrow_source + 2, nothrow_target);
+      io::assert(nothrow_target[0]->a == 1 && nothrow_target[1].has_value() == false);
+      std::destroy_n(nothrow_target, 2);
+      allocator.deallocate(nothrow_target, 2);
+      allocator.deallocate(nothrow_source, 2);
+   }
+   
 } // namespace {}
 
 
@@ -99,4 +185,7 @@ auto io::test_misc() -> void
    test_assignment_from_std();
    test_conversion_to_std();
    test_construction_from_std();
+   test_swap();
+   test_special_members();
+   test_relocate();
 }
@@ -0,0 +1,155 @@
+#include "test_monadic.h"
+
+#include "tests_common.h"
+
+#include <limits>
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<-1>;
+
+
+   constexpr auto half(const int value) -> opt_type
+   {
+      if (value % 2 != 0)
+         return std::nullopt;
+      return value / 2;
+   }
+
+
+   // Counts runtime copies to check that transform() doesn't materialize intermediates
+   struct copy_counter
+   {
+      int value{};
+      static inline int copies = 0;
+
+      constexpr copy_counter(const int v) : value(v) {}
+      constexpr copy_counter(const copy_counter& other)
+         : value(other.value)
+      {
+         if (std::is_constant_evaluated() == false)
+            ++copies;
+      }
+      constexpr auto operator=(const copy_counter& other) -> copy_counter&
+      {
+         value = other.value;
+         return *this;
+      }
+      constexpr auto operator==(const copy_counter&) const -> bool = default;
+   };
+
+
+   auto test_and_then()-> void
+   {
+      static_assert(opt_type(8).and_then(half).and_then(half) == 2);
+      static_assert(opt_type(6).and_then(half).and_then(half).has_value() == false);
+      static_assert(opt_type().and_then(half).has_value() == false);
+      {
+         // The function can return other optionals, including std::optional
+         const opt_type opt(5);
+         const std::optional<double> result = opt.and_then([](const int value) { return std::optional<double>(value * 0.5); });
+         io::assert(result == 2.5);
+      }
+      {
+         bool called = false;
+         const opt_type opt;
+         const auto result = opt.and_then([&](const int value) { called = true; return half(value); });
+         io::assert(result.has_value() == false);
+         io::assert(called == false);
+      }
+   }
+
+
+   auto test_transform()-> void
+   {
+      // Same value_type: keeps the sentinel
+      static_assert(std::is_same_v<decltype(opt_type(1).transform([](const int value) { return value + 1; })), opt_type>);
+      static_assert(opt_type(1).transform([](const int value) { return value + 1; }) == 2);
+
+      // Other types use io::default_null_value
+      static_assert(std::is_same_v<
+         decltype(opt_type(1).transform([](const int value) { return value * 0.5; })),
+         io::intrusive_optional<std::numeric_limits<double>::max()>
+      >);
+      static_assert(opt_type(3).transform([](const int value) { return value * 0.5; }) == 1.5);
+      static_assert(opt_type().transform([](const int value) { return value * 0.5; }).has_value() == false);
+
+      // Explicit sentinel
+      static_assert(std::is_same_v<decltype(opt_type(1).transform<short{ 0 }>([](const int value) { return static_cast<short>(value); })), io::intrusive_optional<short{ 0 }>>);
+      static_assert(opt_type(4).transform<-1.0>([](const int value) { return value * 2.0; }) == 8.0);
+      {
+         // Results equal to the sentinel are null
+         const auto result = opt_type(1).transform<0>([](const int value) { return value - 1; });
+         io::assert(result.has_value() == false);
+      }
+      {
+         copy_counter::copies = 0;
+         const opt_type opt(7);
+         const auto result = opt.transform<copy_counter{ -1 }>([](const int value) { return copy_counter(value); });
+         io::assert(result == copy_counter(7));
+         io::assert(copy_counter::copies == 0);
+      }
+   }
+
+
+   auto test_or_else()-> void
+   {
+      static_assert(opt_type(1).or_else([]() { return opt_type(2); }) == 1);
+      static_assert(opt_type().or_else([]() { return opt_type(2); }) == 2);
+      static_assert(opt_type().or_else([]() { return opt_type(); }).has_value() == false);
+      {
+         bool called = false;
+         const opt_type opt(1);
+         const opt_type result = opt.or_else([&]() { called = true; return opt_type(); });
+         io::assert(result == 1);
+         io::assert(called == false);
+      }
+   }
+
+
+   auto test_value_or_else()-> void
+   {
+      static_assert(opt_type(1).value_or_else([]() { return 2; }) == 1);
+      static_assert(opt_type().value_or_else([]() { return 2; }) == 2);
+      {
+         int calls = 0;
+         const opt_type engaged(1);
+         const opt_type empty;
+         io::assert(engaged.value_or_else([&]() { ++calls; return 2; }) == 1);
+         io::assert(calls == 0);
+         io::assert(empty.value_or_else([&]() { ++calls; return 2; }) == 2);
+         io::assert(calls == 1);
+      }
+   }
+
+
+   auto test_safe_mode()-> void
+   {
+      using safe_type = io::intrusive_optional<-1, io::safety_mode_t::safe>;
+      const safe_type opt(1);
+      io::assert(*opt.transform([](const int value) { return value + 1; }) == 2);
+      bool thrown = false;
+      try
+      {
+         (void)opt.transform([](const int value) { return value - 2; });
+      }
+      catch (const io::unintentionally_null&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+} // namespace {}
+
+
+auto io::test_monadic() -> void
+{
+   test_and_then();
+   test_transform();
+   test_or_else();
+   test_value_or_else();
+   test_safe_mode();
+}
@@ -0,0 +1,178 @@
+#include "test_packed_array.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_algorithms.h"
+#include "../intrusive_optional_packed_array.h"
+
+#include <random>
+#include <vector>
+
+
+namespace
+{
+
+   using array5 = io::packed_optional_array<5>;
+   using array3_zero = io::packed_optional_array<3, 0>;
+
+   static_assert(array5::codes_per_word == 12);
+   static_assert(std::is_same_v<array5::value_type, std::uint8_t>);
+   static_assert(std::is_same_v<array5::optional_type, io::intrusive_optional<std::uint8_t{ 31 }>>);
+   static_assert(std::is_same_v<io::packed_optional_array<12>::value_type, std::uint16_t>);
+
+
+   auto test_proxies() -> void
+   {
+      array5 array(30);
+      io::assert(array.size() == 30);
+      io::assert(array.size_in_bytes() == 3 * sizeof(std::uint64_t));
+      io::assert(array.count_null() == 30);
+      io::assert(array[0].has_value() == false);
+      io::assert(array[29] == std::nullopt);
+
+      array[3] = 7;
+      array[11] = 30;
+      array[12] = 0;
+      io::assert(array[3].has_value());
+      io::assert(*array[3] == 7);
+      io::assert(array[11] == 30);
+      io::assert(array[12].value() == 0);
+      io::assert(array[4].value_or(9) == 9);
+      io::assert(array[3].get_std() == std::optional<std::uint8_t>(7));
+      io::assert(array.count_null() == 27);
+
+      // Writing the null code makes the element null
+      array[11] = 31;
+      io::assert(array[11].has_value() == false);
+
+      array[12].reset();
+      io::assert(array[12].has_value() == false);
+      array[4] = array[3];
+      io::assert(array[4] == 7);
+      array[4] = std::nullopt;
+      io::assert(array[4].has_value() == false);
+
+      const array5::optional_type opt = array[3];
+      io::assert(opt == 7);
+      array[5] = array5::optional_type{};
+      io::assert(array[5].has_value() == false);
+
+      bool thrown = false;
+      try
+      {
+         array[0] = 32;
+      }
+      catch (const std::length_error&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+
+      // A rejected push_back doesn't grow the array
+      const std::size_t size = array.size();
+      thrown = false;
+      try
+      {
+         array.push_back(array5::optional_type{ 32 });
+      }
+      catch (const std::length_error&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+      io::assert(array.size() == size);
+
+      thrown = false;
+      try
+      {
+         (void)array[0].value();
+      }
+      catch (const std::bad_optional_access&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+
+   auto test_resize() -> void
+   {
+      array3_zero array;
+      for (std::uint8_t i = 0; i < 50; ++i)
+      {
+         array.push_back(static_cast<std::uint8_t>(i % 8));
+      }
+      io::assert(array.size() == 50);
+      io::assert(array.count_null() == 7);
+      io::assert(array[8].has_value() == false);
+      io::assert(array[9] == 1);
+
+      // Shrinking and growing again gives nulls
+      array.resize(23);
+      io::assert(array.count_null() == 3);
+      array.resize(40);
+      io::assert(array[30].has_value() == false);
+      io::assert(array.count_null() == 3 + 17);
+   }
+
+
+   auto test_pack_unpack() -> void
+   {
+      using opt_type = array5::optional_type;
+      std::mt19937 generator(42);
+      std::vector<opt_type> column(1000);
+      for (opt_type& opt : column)
+      {
+         *opt = static_cast<std::uint8_t>(generator() % 32);
+      }
+
+      array5 array(1010);
+      array.pack(3, column);
+      io::assert(array.count_null() == io::count_null(column) + 10);
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+         io::assert(*array[i + 3] == *column[i]);
+      }
+
+      // Unaligned ranges of every length around a word
+      for (std::size_t first = 0; first < 30; ++first)
+      {
+         for (std::size_t size = 0; size < 30; ++size)
+         {
+            std::vector<opt_type> output(size);
+            array.unpack(first, output);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+               io::assert(*output[i] == *array[first + i]);
+            }
+         }
+      }
+
+      std::vector<opt_type> output(column.size());
+      array.unpack(3, output);
+      io::assert(output == column);
+
+      // Values outside the domain are rejected before anything is written
+      std::vector<opt_type> invalid(20, opt_type(std::uint8_t{ 1 }));
+      *invalid[19] = 40;
+      bool thrown = false;
+      try
+      {
+         array.pack(3, invalid);
+      }
+      catch (const std::length_error&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+      io::assert(*array[3] == *column[0]);
+   }
+
+} // namespace {}
+
+
+auto io::test_packed_array() -> void
+{
+   test_proxies();
+   test_resize();
+   test_pack_unpack();
+}
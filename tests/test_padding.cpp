@@ -0,0 +1,115 @@
+#include "test_padding.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_padding.h"
+
+#include <cstdint>
+#include <vector>
+
+
+namespace
+{
+
+   struct int_char
+   {
+      std::int32_t i;
+      char c;
+      constexpr auto operator==(const int_char&) const -> bool = default;
+   };
+
+   struct char_double
+   {
+      char c;
+      double d;
+      constexpr auto operator==(const char_double&) const -> bool = default;
+   };
+
+   // Trailing and interior padding
+   using opt_int_char = io::padding_optional<int_char, offsetof(int_char, c) + sizeof(char)>;
+   using opt_char_double = io::padding_optional<char_double, offsetof(char_double, c) + sizeof(char)>;
+
+   static_assert(sizeof(opt_int_char) == sizeof(int_char));
+   static_assert(alignof(opt_int_char) == alignof(int_char));
+   static_assert(sizeof(opt_char_double) == sizeof(char_double));
+   static_assert(std::is_trivially_copyable_v<opt_int_char>);
+   static_assert(io::is_trivially_relocatable_v<opt_int_char>);
+
+   static_assert(io::detail::padding_byte<int_char, 5>);
+   static_assert(io::detail::padding_byte<int_char, 7>);
+   static_assert(io::detail::padding_byte<int_char, 4> == false);
+   static_assert(io::detail::padding_byte<int_char, 0> == false);
+   static_assert(io::detail::padding_byte<char_double, 8> == false);
+   static_assert(io::detail::padding_byte<std::int64_t, 0> == false);
+
+
+   auto test_basics() -> void
+   {
+      opt_int_char opt;
+      io::assert(opt.has_value() == false);
+      io::assert(opt == std::nullopt);
+
+      opt = int_char{ 1, 'a' };
+      io::assert(opt.has_value());
+      io::assert(opt->i == 1);
+      io::assert((*opt).c == 'a');
+      io::assert(opt.value() == int_char{ 1, 'a' });
+      io::assert(opt.get_std().has_value());
+
+      // Values whose bytes are all set are still values
+      opt.emplace(-1, static_cast<char>(-1));
+      io::assert(opt.has_value());
+      io::assert(opt->i == -1);
+
+      opt.reset();
+      io::assert(opt.has_value() == false);
+      io::assert(opt.value_or(int_char{ 2, 'b' }).i == 2);
+      io::assert(opt.get_std().has_value() == false);
+
+      bool thrown = false;
+      try
+      {
+         (void)opt.value();
+      }
+      catch (const std::bad_optional_access&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+
+   auto test_copies() -> void
+   {
+      opt_char_double opt(char_double{ 'x', 2.5 });
+      opt_char_double copy = opt;
+      io::assert(copy.has_value());
+      io::assert(copy == opt);
+
+      opt_char_double empty;
+      copy.swap(empty);
+      io::assert(copy.has_value() == false);
+      io::assert(empty->d == 2.5);
+      io::assert(copy != opt);
+
+      // A vector grows with memmove and keeps the flags
+      std::vector<opt_int_char> column;
+      for (std::int32_t i = 0; i < 100; ++i)
+      {
+         column.push_back(i % 3 == 0 ? opt_int_char{} : opt_int_char(int_char{ i, 'z' }));
+      }
+      for (std::int32_t i = 0; i < 100; ++i)
+      {
+         io::assert(column[i].has_value() == (i % 3 != 0));
+         if (column[i].has_value())
+            io::assert(column[i]->i == i);
+      }
+   }
+
+} // namespace {}
+
+
+auto io::test_padding() -> void
+{
+   test_basics();
+   test_copies();
+}
@@ -13,7 +13,7 @@ namespace
       {
          fun();
       }
-      catch (exception_type)
+      catch (const exception_type&)
       {
          return true;
       }
@@ -58,7 +58,7 @@ namespace
       auto lambda = []()
       {
          opt_type value;
-         value = 0ui8;
+         value = std::uint8_t{ 0 };
       };
       io::assert(has_thrown(lambda));
       
@@ -107,6 +107,84 @@ namespace
    }
    
    
+
+
+   struct record
+   {
+      int id = 0;
+      int payload[3]{};
+      constexpr auto operator==(const record& other) const -> bool
+      {
+         return id == other.id;
+      }
+   };
+
+   using record_optional = io::intrusive_optional<record{ -1 }, io::safety_mode_t::safe>;
+
+
+   auto test_modify()-> void
+   {
+      record_optional value(record{ 1 });
+      value.modify([](record& r) { r.payload[0] = 5; });
+      io::assert((*value).payload[0] == 5);
+
+      // Returns what the function returns, also references
+      io::assert(value.modify([](record& r) { return ++r.id; }) == 2);
+      int& id = value.modify([](record& r) -> int& { return r.id; });
+      io::assert(&id == &(*value).id);
+
+      // Checked once at the end, so intermediate nulls are fine
+      value.modify([](record& r) { r.id = -1; r.id = 3; });
+      io::assert(value->id == 3);
+
+      io::assert(has_thrown([&]() { value.modify([](record& r) { r.id = -1; }); }));
+
+      using opt_type = io::intrusive_optional<-1, io::safety_mode_t::safe>;
+      constexpr auto lambda = []()
+      {
+         opt_type number(4);
+         number.modify([](int& i) { --i; });
+         io::assert(*number == 3);
+         number.modify([](int& i) { i = -1; });
+      };
+      io::assert(has_thrown(lambda));
+
+      // A null optional is a bad access, and f isn't called
+      record_optional null;
+      bool called = false;
+      io::assert(has_thrown_impl<std::bad_optional_access>([&]() { null.modify([&](record&) { called = true; }); }));
+      io::assert(called == false);
+      io::assert(null->id == -1);
+   }
+
+} // namespace {}
+
+
+// The payload doesn't take part in the comparison
+template <>
+struct io::sentinel_independent_member<&record::payload> : std::true_type {};
+
+
+namespace
+{
+
+   auto test_modify_member()-> void
+   {
+      record_optional value(record{ 1 });
+      value.modify<&record::payload>([](int (&payload)[3]) { payload[2] = 7; });
+      io::assert(value->payload[2] == 7);
+
+      // The id is checked
+      io::assert(value.modify<&record::id>([](int& id) { return id += 1; }) == 2);
+      io::assert(has_thrown([&]() { value.modify<&record::id>([](int& id) { id = -1; }); }));
+
+      // Also for independent members
+      record_optional null;
+      io::assert(has_thrown_impl<std::bad_optional_access>([&]() { null.modify<&record::id>([](int& id) { id = 1; }); }));
+      io::assert(has_thrown_impl<std::bad_optional_access>([&]() { null.modify<&record::payload>([](int (&payload)[3]) { payload[0] = 1; }); }));
+      io::assert(null.has_value() == false);
+   }
+
 } // namespace {}
 
 
@@ -120,4 +198,6 @@ auto io::test_safety() -> void
    test_value();
    test_emplace_1();
    test_emplace_2();
+   test_modify();
+   test_modify_member();
 }
@@ -0,0 +1,111 @@
+#include "test_slot_map.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_slot_map.h"
+
+
+namespace
+{
+
+   using map_type = io::slot_map<-1>;
+
+   auto has_thrown(map_type& map, const int value) -> bool
+   {
+      try
+      {
+         (void)map.insert(value);
+      }
+      catch (const io::unintentionally_null&)
+      {
+         return true;
+      }
+      return false;
+   }
+
+
+   auto test_insert_erase()-> void
+   {
+      map_type map;
+      const map_type::handle a = map.insert(1);
+      const map_type::handle b = map.insert(2);
+      const map_type::handle c = map.insert(3);
+      io::assert(map.size() == 3);
+      io::assert(*map.find(b) == 2);
+
+      io::assert(map.erase(b));
+      io::assert(map.erase(b) == false);
+      io::assert(map.contains(b) == false);
+      io::assert(map.find(b) == nullptr);
+      io::assert(map.size() == 2);
+
+      // The slot is reused with a new generation, the old handle stays invalid
+      const map_type::handle d = map.insert(4);
+      io::assert(d.index() == b.index());
+      io::assert(d.generation() != b.generation());
+      io::assert(map.contains(b) == false);
+      io::assert(*map.find(d) == 4);
+      io::assert(*map.find(a) == 1);
+      io::assert(*map.find(c) == 3);
+
+      io::assert(map.contains(map_type::handle{}) == false);
+   }
+
+
+   auto test_null_insert()-> void
+   {
+      map_type map;
+      io::assert(has_thrown(map, -1));
+      io::assert(map.empty());
+      const map_type::handle a = map.insert(1);
+      map.erase(a);
+      io::assert(has_thrown(map, -1));
+      io::assert(map.empty());
+      io::assert(*map.find(map.insert(2)) == 2);
+   }
+
+
+   auto test_iteration()-> void
+   {
+      map_type map;
+      std::vector<map_type::handle> handles;
+      for (int i = 0; i < 100; ++i)
+      {
+         handles.push_back(map.insert(i));
+      }
+      for (int i = 0; i < 100; ++i)
+      {
+         if (i % 3 != 0)
+            map.erase(handles[i]);
+      }
+
+      int sum = 0;
+      for (const int value : map.values())
+      {
+         io::assert(value % 3 == 0);
+         sum += value;
+      }
+      io::assert(sum == 1683);
+
+      std::size_t count = 0;
+      map.for_each([&](const map_type::handle h, int& value)
+      {
+         io::assert(h == handles[value]);
+         ++count;
+      });
+      io::assert(count == map.size());
+
+      map.clear();
+      io::assert(map.empty());
+      io::assert(map.contains(handles[0]) == false);
+      io::assert((map.values()).empty());
+   }
+
+} // namespace {}
+
+
+auto io::test_slot_map() -> void
+{
+   test_insert_erase();
+   test_null_insert();
+   test_iteration();
+}
@@ -0,0 +1,72 @@
+#include "test_static_map.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_static_map.h"
+
+#include <string>
+
+
+namespace
+{
+
+   constexpr auto keywords = io::make_static_map<-1, std::string_view>({
+      { "if", 0 }, { "else", 1 }, { "while", 2 }, { "for", 3 }, { "return", 4 }, { "break", 5 },
+      { "continue", 6 }, { "switch", 7 }, { "case", 8 }, { "default", 9 }, { "do", 10 }, { "goto", 11 }
+   });
+   static_assert(keywords.find("while") == 2);
+   static_assert(keywords.find("return") == 4);
+   static_assert(keywords.find("goto") == 11);
+   static_assert(keywords.find("loop").has_value() == false);
+   static_assert(keywords.find("").has_value() == false);
+   static_assert(keywords.size() == 12);
+   static_assert(std::is_same_v<decltype(keywords.find("if")), io::intrusive_optional<-1>>);
+
+   enum class opcode : std::uint8_t { nop = 0x00, load = 0x12, store = 0x37, jump = 0x80, halt = 0xff };
+   constexpr auto opcode_lengths = io::make_static_map<std::uint8_t{ 0 }, opcode>({
+      { opcode::nop, std::uint8_t{ 1 } }, { opcode::load, std::uint8_t{ 3 } }, { opcode::store, std::uint8_t{ 3 } },
+      { opcode::jump, std::uint8_t{ 2 } }, { opcode::halt, std::uint8_t{ 1 } }
+   });
+   static_assert(opcode_lengths.find(opcode::store) == 3);
+   static_assert(opcode_lengths.find(opcode::nop) == 1);
+   static_assert(opcode_lengths.find(static_cast<opcode>(0x13)).has_value() == false);
+
+   constexpr auto single = io::make_static_map<-1, int>({ { 42, 7 } });
+   static_assert(single.find(42) == 7);
+   static_assert(single.find(0).has_value() == false);
+
+
+   auto test_large_table()-> void
+   {
+      // Every key of a larger table is found at runtime, other keys aren't
+      constexpr auto squares = []()
+      {
+         std::pair<int, int> entries[200]{};
+         for (int i = 0; i < 200; ++i)
+         {
+            entries[i] = { i * 7 + 3, i * i };
+         }
+         return io::make_static_map<-1>(entries);
+      }();
+      for (int i = 0; i < 200; ++i)
+      {
+         io::assert(squares.find(i * 7 + 3) == i * i);
+         io::assert(squares.contains(i * 7 + 4) == false);
+      }
+   }
+
+
+   auto test_runtime_keys()-> void
+   {
+      const std::string key = "continue";
+      io::assert(keywords.find(key) == 6);
+      io::assert(keywords.find(key + "s").has_value() == false);
+   }
+
+} // namespace {}
+
+
+auto io::test_static_map() -> void
+{
+   test_large_table();
+   test_runtime_keys();
+}
@@ -0,0 +1,147 @@
+#include "test_tagged_ptr.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_tagged_ptr.h"
+
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+   struct alignas(8) node
+   {
+      int value = 0;
+   };
+
+   using ptr_type = io::tagged_optional_ptr<node, 3>;
+
+   static_assert(sizeof(ptr_type) == sizeof(node*));
+   static_assert(std::is_trivially_copyable_v<ptr_type>);
+   static_assert(ptr_type::tag_mask == 0b111);
+   static_assert(ptr_type().has_value() == false);
+   static_assert(ptr_type::from_word(0b101).has_value() == false);
+   static_assert(ptr_type::from_word(0b101).tag() == 0b101);
+   static_assert(io::atomic_tagged_optional_ptr<node, 3>::is_always_lock_free);
+
+
+   auto test_basics() -> void
+   {
+      node n{ 5 };
+      ptr_type ptr(&n, 0b010);
+      io::assert(ptr.has_value());
+      io::assert(ptr.get() == &n);
+      io::assert(ptr->value == 5);
+      io::assert(ptr.value().value == 5);
+      io::assert(ptr.tag() == 0b010);
+      io::assert(ptr.flag(1));
+      io::assert(ptr.flag(0) == false);
+      io::assert(*ptr.pointer() == &n);
+
+      ptr.set_flag(0);
+      ptr.set_flag(1, false);
+      io::assert(ptr.tag() == 0b001);
+      io::assert(ptr.get() == &n);
+
+      // Bits outside the tag don't touch the pointer
+      ptr.set_flag(3);
+      ptr.set_flag(63);
+      io::assert(ptr.flag(3) == false);
+      io::assert(ptr.tag() == 0b001);
+      io::assert(ptr.get() == &n);
+
+      // Flags don't make a null pointer engaged
+      ptr.reset();
+      io::assert(ptr.has_value() == false);
+      io::assert(ptr == std::nullopt);
+      io::assert(ptr.tag() == 0b001);
+      io::assert(ptr.pointer().has_value() == false);
+
+      ptr.set_pointer(&n);
+      io::assert(ptr.get() == &n);
+      io::assert(ptr.tag() == 0b001);
+      io::assert(ptr != ptr_type(&n, 0b011));
+
+      ptr.set_tag(0b1111);
+      io::assert(ptr.tag() == 0b111);
+
+      ptr_type other;
+      ptr.swap(other);
+      io::assert(ptr.has_value() == false);
+      io::assert(other.get() == &n);
+
+      bool thrown = false;
+      try
+      {
+         (void)ptr.value();
+      }
+      catch (const std::bad_optional_access&)
+      {
+         thrown = true;
+      }
+      io::assert(thrown);
+   }
+
+
+   auto test_atomic() -> void
+   {
+      node a{ 1 };
+      node b{ 2 };
+      io::atomic_tagged_optional_ptr<node, 3> atomic(ptr_type(&a, 1));
+
+      ptr_type expected(&b, 0);
+      io::assert(atomic.compare_exchange_strong(expected, ptr_type(&b, 2)) == false);
+      io::assert(expected == ptr_type(&a, 1));
+      io::assert(atomic.compare_exchange_strong(expected, ptr_type(&b, 2)));
+      io::assert(atomic.load() == ptr_type(&b, 2));
+
+      const ptr_type previous = atomic.fetch_set_flag(0);
+      io::assert(previous.tag() == 2);
+      io::assert(atomic.load().tag() == 3);
+      atomic.fetch_clear_flag(1);
+      io::assert(atomic.load() == ptr_type(&b, 1));
+      atomic.fetch_set_flag(3);
+      atomic.fetch_clear_flag(4);
+      io::assert(atomic.load() == ptr_type(&b, 1));
+
+      io::assert(atomic.exchange(ptr_type{}) == ptr_type(&b, 1));
+      io::assert(atomic.load().has_value() == false);
+
+      // Concurrent flag toggles and pointer swaps don't lose updates
+      atomic.store(ptr_type(&a, 0));
+      constexpr int iterations = 10000;
+      std::thread setter([&]()
+      {
+         for (int i = 0; i < iterations; ++i)
+         {
+            atomic.fetch_set_flag(2);
+            atomic.fetch_clear_flag(2);
+         }
+      });
+      int swaps = 0;
+      for (int i = 0; i < iterations; ++i)
+      {
+         ptr_type current = atomic.load();
+         ptr_type desired = current;
+         do
+         {
+            desired = current;
+            desired.set_pointer(current.get() == &a ? &b : &a);
+         } while (atomic.compare_exchange_weak(current, desired) == false);
+         ++swaps;
+      }
+      setter.join();
+      io::assert(atomic.load().get() == (swaps % 2 == 0 ? &a : &b));
+      io::assert(atomic.load().flag(2) == false);
+   }
+
+} // namespace {}
+
+
+auto io::test_tagged_ptr() -> void
+{
+   test_basics();
+   test_atomic();
+}
@@ -0,0 +1,5 @@
+#pragma once
+
+namespace io {
+   auto test_tagged_ptr() -> void;
+}
@@ -0,0 +1,160 @@
+#include "test_telemetry.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_telemetry.h"
+
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+
+   using counted_type = io::intrusive_optional<-1, io::safety_mode_t::unsafe, io::counting_telemetry>;
+   using counted_safe_type = io::intrusive_optional<-1, io::safety_mode_t::safe, io::counting_telemetry>;
+
+   static_assert(sizeof(counted_type) == sizeof(int));
+   static_assert(std::is_trivially_copyable_v<counted_type>);
+
+   // Telemetry is skipped during constant evaluation
+   static_assert(counted_type(5).has_value());
+   static_assert(counted_type().value_or(3) == 3);
+
+   // The non-members keep the mode and policies
+   static_assert(std::is_same_v<decltype(io::make_optional<-1>(3)), io::intrusive_optional<-1>>);
+   static_assert(std::is_same_v<decltype(io::make_optional<-1, io::safety_mode_t::safe>(3)), io::intrusive_optional<-1, io::safety_mode_t::safe>>);
+   static_assert(std::is_same_v<decltype(io::make_optional<-1, io::safety_mode_t::safe, io::counting_telemetry>(3)), counted_safe_type>);
+   static_assert(requires(counted_safe_type& lhs, counted_safe_type& rhs) { io::swap(lhs, rhs); });
+
+
+   auto test_observations() -> void
+   {
+      // Every test uses its own sentinel, so the counters start at zero
+      using opt_type = io::intrusive_optional<-2, io::safety_mode_t::unsafe, io::counting_telemetry>;
+      opt_type value = 5;
+      const opt_type null;
+      io::assert(value.has_value());
+      io::assert(bool(value));
+      io::assert(null.has_value() == false);
+      io::assert((null != std::nullopt) == false);
+      value.reset();
+      value.reset();
+
+      const io::telemetry_counters counters = io::counting_telemetry::counters<opt_type>();
+      io::assert(counters.value_observations == 2);
+      io::assert(counters.null_observations == 2);
+      io::assert(counters.resets == 2);
+      io::assert(counters.sentinel_collisions == 0);
+      io::assert(counters.null_rate() == 0.5);
+   }
+
+
+   auto test_collisions_and_bad_access() -> void
+   {
+      counted_type value(-1);
+      value = 4;
+      value = -1;
+      value.emplace(-1);
+      try
+      {
+         [[maybe_unused]] const int i = value.value();
+      }
+      catch (const std::bad_optional_access&)
+      {
+      }
+      io::assert(io::counting_telemetry::counters<counted_type>().sentinel_collisions == 3);
+      io::assert(io::counting_telemetry::counters<counted_type>().bad_accesses == 1);
+
+      // Safe mode counts the collision before it throws
+      try
+      {
+         counted_safe_type safe(-1);
+      }
+      catch (const io::unintentionally_null&)
+      {
+      }
+      io::assert(io::counting_telemetry::counters<counted_safe_type>().sentinel_collisions == 1);
+   }
+
+
+   auto test_internal_calls_not_counted() -> void
+   {
+      // Members that check or clear the value internally don't count as observations or resets
+      using opt_type = io::intrusive_optional<-3, io::safety_mode_t::unsafe, io::counting_telemetry>;
+      opt_type value = 1;
+      opt_type other;
+      value.emplace(2);
+      value.swap(other);
+      swap(value, other);
+      value = other;
+      [[maybe_unused]] const int i = value.value_or(0) + *value;
+      io::assert(io::counting_telemetry::counters<opt_type>() == io::telemetry_counters{});
+   }
+
+
+   auto test_threads() -> void
+   {
+      // Counters of exited threads are kept
+      using opt_type = io::intrusive_optional<-4, io::safety_mode_t::unsafe, io::counting_telemetry>;
+      constexpr int thread_count = 4;
+      constexpr int iterations = 1000;
+      std::vector<std::thread> threads;
+      for (int t = 0; t < thread_count; ++t)
+      {
+         threads.emplace_back([]()
+         {
+            for (int i = 0; i < iterations; ++i)
+            {
+               const opt_type value = i % 4 == 0 ? opt_type() : opt_type(i);
+               [[maybe_unused]] const bool has_value = value.has_value();
+            }
+         });
+      }
+      for (std::thread& thread : threads)
+      {
+         thread.join();
+      }
+      opt_type().has_value();
+
+      const io::telemetry_counters counters = io::counting_telemetry::counters<opt_type>();
+      io::assert(counters.value_observations == thread_count * iterations * 3 / 4);
+      io::assert(counters.null_observations == thread_count * iterations / 4 + 1);
+   }
+
+
+   auto test_dump() -> void
+   {
+      using opt_type = io::intrusive_optional<-5, io::safety_mode_t::unsafe, io::counting_telemetry>;
+      opt_type value;
+      value.reset();
+
+      bool found = false;
+      for (const io::telemetry_record& record : io::telemetry_snapshot())
+      {
+         if (record.type_name.find("-5") != std::string_view::npos)
+         {
+            found = true;
+            io::assert(record.counters.resets == 1);
+         }
+      }
+      io::assert(found);
+
+      std::ostringstream stream;
+      io::dump_telemetry(stream);
+      io::assert(stream.str().find("resets 1") != std::string::npos);
+   }
+
+} // namespace {}
+
+
+auto io::test_telemetry() -> void
+{
+   test_observations();
+   test_collisions_and_bad_access();
+   test_internal_calls_not_counted();
+   test_threads();
+   test_dump();
+}
@@ -0,0 +1,162 @@
+#include "test_views.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_views.h"
+
+#include <algorithm>
+#include <array>
+#include <limits>
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<-1>;
+   using view_type = decltype(std::declval<std::vector<opt_type>&>() | io::views::engaged);
+   using indices_type = decltype(std::declval<std::vector<opt_type>&>() | io::views::indices_engaged);
+   using values_or_type = decltype(std::declval<std::vector<opt_type>&>() | io::views::values_or(0));
+
+   static_assert(std::ranges::bidirectional_range<view_type>);
+   static_assert(std::ranges::common_range<view_type>);
+   static_assert(std::ranges::borrowed_range<view_type>);
+   static_assert(std::ranges::view<view_type>);
+   static_assert(std::is_same_v<std::ranges::range_reference_t<view_type>, int&>);
+   static_assert(std::ranges::bidirectional_range<indices_type>);
+   static_assert(std::is_same_v<std::ranges::range_reference_t<indices_type>, std::size_t>);
+   static_assert(std::ranges::random_access_range<values_or_type>);
+   static_assert(std::ranges::sized_range<values_or_type>);
+
+
+   // Null pattern with long null runs and isolated values to exercise the block skipping
+   auto make_column(const std::size_t size) -> std::vector<opt_type>
+   {
+      std::vector<opt_type> result(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+         if (i % 97 == 3 || i % 41 == 40 || (i > 200 && i < 230))
+            result[i].emplace(static_cast<int>(i));
+      }
+      return result;
+   }
+
+
+   auto test_engaged()-> void
+   {
+      {
+         std::vector<opt_type> column = make_column(1000);
+         std::vector<int> expected;
+         for (const opt_type& element : column)
+         {
+            if (element.has_value())
+               expected.push_back(*element);
+         }
+
+         std::vector<int> forward;
+         for (const int value : column | io::views::engaged)
+         {
+            forward.push_back(value);
+         }
+         io::assert(forward == expected);
+
+         std::vector<int> backward;
+         for (const int value : column | io::views::engaged | std::views::reverse)
+         {
+            backward.push_back(value);
+         }
+         std::ranges::reverse(backward);
+         io::assert(backward == expected);
+
+         // The references refer to the column
+         for (int& value : column | io::views::engaged)
+         {
+            value = 0;
+         }
+         io::assert(std::ranges::count(column, opt_type(0)) == static_cast<std::ptrdiff_t>(expected.size()));
+      }
+      {
+         std::vector<opt_type> column(100);
+         io::assert((column | io::views::engaged).empty());
+         column[99] = 5;
+         io::assert((column | io::views::engaged).front() == 5);
+         io::assert((column | io::views::engaged).back() == 5);
+      }
+      {
+         constexpr auto sum = []()
+         {
+            const std::array<opt_type, 4> column{ opt_type(1), opt_type(), opt_type(2), opt_type() };
+            int result = 0;
+            for (const int value : column | io::views::engaged)
+            {
+               result += value;
+            }
+            return result;
+         };
+         static_assert(sum() == 3);
+      }
+   }
+
+
+   auto test_indices_engaged()-> void
+   {
+      const std::vector<opt_type> column = make_column(1000);
+      std::vector<std::size_t> expected;
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+         if (column[i].has_value())
+            expected.push_back(i);
+      }
+      std::vector<std::size_t> indices;
+      for (const std::size_t i : column | io::views::indices_engaged)
+      {
+         indices.push_back(i);
+      }
+      io::assert(indices == expected);
+   }
+
+
+   auto test_values_or()-> void
+   {
+      const std::vector<opt_type> column{ opt_type(1), opt_type(), opt_type(3) };
+      const auto values = column | io::views::values_or(0);
+      io::assert(values.size() == 3);
+      io::assert(values[0] == 1);
+      io::assert(values[1] == 0);
+      io::assert(values[2] == 3);
+   }
+
+
+   auto test_nan_sentinel()-> void
+   {
+      using nan_opt = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+      std::vector<nan_opt> column(100);
+      column[2] = 2.0;
+      column[70] = 70.0;
+
+      std::vector<double> engaged;
+      for (const double value : column | io::views::engaged)
+      {
+         engaged.push_back(value);
+      }
+      io::assert((engaged == std::vector<double>{ 2.0, 70.0 }));
+
+      std::vector<std::size_t> indices;
+      for (const std::size_t index : column | io::views::indices_engaged)
+      {
+         indices.push_back(index);
+      }
+      io::assert((indices == std::vector<std::size_t>{ 2, 70 }));
+
+      const auto values = column | io::views::values_or(-1.0);
+      io::assert(std::ranges::count(values, -1.0) == 98);
+   }
+
+} // namespace {}
+
+
+auto io::test_views() -> void
+{
+   test_engaged();
+   test_indices_engaged();
+   test_values_or();
+   test_nan_sentinel();
+}
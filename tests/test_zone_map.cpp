@@ -0,0 +1,141 @@
+#include "test_zone_map.h"
+
+#include "tests_common.h"
+#include "../intrusive_optional_zone_map.h"
+
+#include <limits>
+
+
+namespace
+{
+
+   using opt_type = io::intrusive_optional<std::numeric_limits<double>::max()>;
+   using map_type = io::zone_map<std::numeric_limits<double>::max(), 16>;
+
+   auto make_column() -> std::vector<opt_type>
+   {
+      // Ascending values with every third element and the whole second block null
+      std::vector<opt_type> column(100);
+      for (std::size_t i = 0; i < column.size(); ++i)
+      {
+         if (i % 3 == 0 || (i >= 16 && i < 32))
+            continue;
+         column[i].emplace(static_cast<double>(i));
+      }
+      return column;
+   }
+
+
+   auto count_naive(const std::vector<opt_type>& column, const double lo, const double hi) -> std::size_t
+   {
+      std::size_t result = 0;
+      for (const opt_type& element : column)
+      {
+         if (element.has_value() && lo <= *element && *element <= hi)
+            ++result;
+      }
+      return result;
+   }
+
+
+   auto test_build()-> void
+   {
+      std::vector<opt_type> column = make_column();
+      const map_type map(column);
+      io::assert(map.zones().size() == 7);
+      io::assert(map.zones()[0].min == 1.0);
+      io::assert(map.zones()[0].max == 14.0);
+      io::assert(map.zones()[0].null_count == 6);
+      io::assert(map.zones()[1].null_count == 16);
+      io::assert(map.zones()[6].null_count == 2);
+   }
+
+
+   auto test_scan_where()-> void
+   {
+      std::vector<opt_type> column = make_column();
+      const map_type map(column);
+      io::assert(map.count_where(0.0, 100.0) == count_naive(column, 0.0, 100.0));
+      io::assert(map.count_where(10.0, 40.0) == count_naive(column, 10.0, 40.0));
+      io::assert(map.count_where(17.0, 30.0) == 0);
+      io::assert(map.count_where(200.0, 300.0) == 0);
+
+      std::vector<std::size_t> indices;
+      map.scan_where(4.0, 8.0, [&](const std::size_t index, const double) { indices.push_back(index); });
+      io::assert((indices == std::vector<std::size_t>{4, 5, 7, 8}));
+   }
+
+
+   auto test_updates()-> void
+   {
+      std::vector<opt_type> column = make_column();
+      map_type map(column);
+      map.set(20, 500.0);
+      io::assert(*column[20] == 500.0);
+      io::assert(map.zones()[1].null_count == 15);
+      io::assert(map.count_where(400.0, 600.0) == 1);
+
+      map.reset(20);
+      io::assert(column[20].has_value() == false);
+      io::assert(map.zones()[1].null_count == 16);
+      io::assert(map.count_where(400.0, 600.0) == 0);
+
+      map.set(1, opt_type::null_value);
+      io::assert(map.zones()[0].null_count == 7);
+      io::assert(map.count_where(0.0, 100.0) == count_naive(column, 0.0, 100.0));
+   }
+
+
+   auto test_nan_sentinel()-> void
+   {
+      using nan_opt = io::intrusive_optional<std::numeric_limits<double>::quiet_NaN()>;
+      std::vector<nan_opt> column(32);
+      column[3] = 3.0;
+      column[20] = 20.0;
+      io::zone_map<nan_opt::null_value, 16> map(column);
+      io::assert(map.zones()[0].null_count == 15);
+      io::assert(map.zones()[0].min == 3.0 && map.zones()[0].max == 3.0);
+      io::assert(map.count_where(0.0, 100.0) == 2);
+
+      map.set(4, nan_opt::null_value);
+      io::assert(map.zones()[0].null_count == 15);
+      map.set(3, nan_opt::null_value);
+      io::assert(column[3].has_value() == false);
+      io::assert(map.zones()[0].null_count == 16);
+      io::assert(map.count_where(0.0, 100.0) == 1);
+   }
+
+
+   // NaN values are never in range, also in blocks whose min and max are
+   auto test_nan_values()-> void
+   {
+      const double nan = std::numeric_limits<double>::quiet_NaN();
+      std::vector<opt_type> column(32, opt_type{ 1.0 });
+      column[3] = nan;
+      map_type map(column);
+      io::assert(map.zones()[0].has_nan);
+      io::assert(map.zones()[1].has_nan == false);
+      std::size_t count = 0;
+      map.scan_where(0.0, 2.0, [&](const std::size_t index, const double value)
+      {
+         io::assert(index != 3 && value == 1.0);
+         ++count;
+      });
+      io::assert(count == 31);
+
+      map.set(20, nan);
+      io::assert(map.zones()[1].has_nan);
+      io::assert(map.count_where(0.0, 2.0) == 30);
+   }
+   
+} // namespace {}
+
+
+auto io::test_zone_map() -> void
+{
+   test_build();
+   test_scan_where();
+   test_updates();
+   test_nan_sentinel();
+   test_nan_values();
+}
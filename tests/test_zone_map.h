@@ -0,0 +1,5 @@
+#pragma once
+
+namespace io {
+   auto test_zone_map() -> void;
+}
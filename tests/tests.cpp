@@ -3,6 +3,26 @@
 #include "test_assignments.h"
 #include "test_safety.h"
 #include "test_misc.h"
+#include "test_monadic.h"
+#include "test_algorithms.h"
+#include "test_codecs.h"
+#include "test_zone_map.h"
+#include "test_expressions.h"
+#include "test_fill.h"
+#include "test_join.h"
+#include "test_views.h"
+#include "test_slot_map.h"
+#include "test_gapped_array.h"
+#include "test_static_map.h"
+#include "test_compact.h"
+#include "test_by_member.h"
+#include "test_padding.h"
+#include "test_tagged_ptr.h"
+#include "test_packed_array.h"
+#include "test_convert.h"
+#include "test_telemetry.h"
+#include "test_failure.h"
+#include "test_debug.h"
 
 
 int main()
@@ -12,6 +32,26 @@ int main()
    io::test_assignments();
    io::test_safety();
    io::test_misc();
+   io::test_monadic();
+   io::test_algorithms();
+   io::test_codecs();
+   io::test_zone_map();
+   io::test_expressions();
+   io::test_fill();
+   io::test_join();
+   io::test_views();
+   io::test_slot_map();
+   io::test_gapped_array();
+   io::test_static_map();
+   io::test_compact();
+   io::test_by_member();
+   io::test_padding();
+   io::test_tagged_ptr();
+   io::test_packed_array();
+   io::test_convert();
+   io::test_telemetry();
+   io::test_failure();
+   io::test_debug();
 
    return 0;
 }
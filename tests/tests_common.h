@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <vector>
 
 #include "../intrusive_optional.h"
@@ -24,6 +25,7 @@ namespace io
       {
          
       }
+      constexpr one_value& operator=(const one_value&) = default;
       constexpr one_value(int p) : a(p) {}
       constexpr one_value(const std::initializer_list<int>& ilist)
          : a(*ilist.begin())
@@ -40,12 +42,7 @@ namespace io
    {
       int m_a{};
       int m_b{};
-      two_values& operator=(const two_values& other)
-      {
-         m_a = other.m_a;
-         m_b = other.m_b;
-         return *this;
-      }
+      constexpr two_values& operator=(const two_values&) = default;
       constexpr two_values() = default;
 
       constexpr two_values(const std::initializer_list<int>& ilist)